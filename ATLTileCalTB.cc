@@ -10,6 +10,7 @@
 //
 #include "ATLTileCalTBActInitialization.hh"
 #include "ATLTileCalTBDetConstruction.hh"
+#include "ATLTileCalTBEmPresets.hh"
 #ifdef G4_USE_FLUKA
 // include the FTFP_BERT PL custmized with fluka
 // hadron inelastic process
@@ -27,6 +28,10 @@
 // #include "G4RunManagerFactory.hh" //only available from 10.7 on
 #include "G4GDMLParser.hh"
 #include "G4PhysListFactory.hh"
+#include "G4StepLimiterPhysics.hh"
+#ifdef ATLTileCalTB_FastSim
+#include "G4FastSimulationPhysics.hh"
+#endif
 #include "G4UIExecutive.hh"
 #include "G4UIcommand.hh"
 #include "G4UImanager.hh"
@@ -51,6 +56,9 @@ void PrintHelp() {
          << "  -u UISESSION    string of the Geant4 UI session to use\n"
          << "  -t THREADS      number of threads to use in the simulation\n"
          << "  -p PHYSICSLIST  string of the physics list to use\n"
+         << "  -e EMPRESET     EM parameters preset (default, validation, fast)\n"
+         << "  -l USERLIMITS   1 to register the step limiter for /tiletb/region/minEkin\n"
+         << "                  and maxTime (default 0, no per-step cost)\n"
          << "  -h              print this help and exit\n"
          << G4endl;
 }
@@ -79,12 +87,25 @@ void PLFactoryUsageError() {
 }
 } // namespace PrintPLFactoryUsageError
 
+// G4err output for EM preset usage error
+//
+namespace PrintEmPresetUsageError {
+void EmPresetUsageError() {
+  G4cerr << "Wrong EM preset selected, valid names are:";
+  for (const auto& name : ATLTileCalTBEmPresets::GetNames())
+    G4cerr << " " << name;
+  G4cerr << G4endl;
+}
+} // namespace PrintEmPresetUsageError
+
 int main(int argc, char **argv) {
 
   // CLI variables
   G4String macro;
   G4String session;
   G4String custom_pl = "FTFP_BERT"; // default physics list
+  G4String em_preset = "default";    // EM parameters of the physics list
+  G4bool user_limits = false;         // G4StepLimiterPhysics (per-step cost)
 #ifdef G4MULTITHREADED
   G4int nThreads = G4Threading::G4GetNumberOfCores();
 #endif
@@ -97,6 +118,10 @@ int main(int argc, char **argv) {
       session = argv[i + 1];
     else if (G4String(argv[i]) == "-p")
       custom_pl = argv[i + 1];
+    else if (G4String(argv[i]) == "-e")
+      em_preset = argv[i + 1];
+    else if (G4String(argv[i]) == "-l")
+      user_limits = G4UIcommand::ConvertToBool(argv[i + 1]);
 #ifdef G4MULTITHREADED
     else if (G4String(argv[i]) == "-t") {
       nThreads = G4UIcommand::ConvertToInt(argv[i + 1]);
@@ -158,9 +183,28 @@ int main(int argc, char **argv) {
     return 1;
   }
   auto physicsList = physListFactory->GetReferencePhysList(custom_pl);
+  // user limits of the calorimeter regions (/tiletb/region/), opt-in as
+  // G4StepLimiter and G4UserSpecialCuts run on every step of every particle
+  if (user_limits)
+    physicsList->RegisterPhysics(new G4StepLimiterPhysics());
+#ifdef ATLTileCalTB_FastSim
+  // shower library model of the calorimeter (/tiletb/library/)
+  auto fastSimulationPhysics = new G4FastSimulationPhysics();
+  for (const auto particle : {"e-", "e+", "gamma"})
+    fastSimulationPhysics->ActivateFastSimulation(particle);
+  physicsList->RegisterPhysics(fastSimulationPhysics);
+#endif
   runManager->SetUserInitialization(physicsList);
 #else // build the customized FTFP_BERT PL with Flula.Cern
   auto physList = new G4_CernFLUKAHadronInelastic_FTFP_BERT;
+  if (user_limits)
+    physList->RegisterPhysics(new G4StepLimiterPhysics());
+#ifdef ATLTileCalTB_FastSim
+  auto fastSimulationPhysics = new G4FastSimulationPhysics();
+  for (const auto particle : {"e-", "e+", "gamma"})
+    fastSimulationPhysics->ActivateFastSimulation(particle);
+  physList->RegisterPhysics(fastSimulationPhysics);
+#endif
   runManager->SetUserInitialization(physList);
   // Initialize FLUKA <-> G4 particles conversions tables.
   fluka_particle_table::initialize();
@@ -188,9 +232,17 @@ int main(int argc, char **argv) {
 #endif // #if G4VERSION_NUMBER >= 1110
 #endif // #ifndef G4_USE_FLUKA
 
+  // Set EM parameters preset (after the physics list constructors
+  // that set their own EM parameters)
+  //
+  if (!ATLTileCalTBEmPresets::Apply(em_preset)) {
+    PrintEmPresetUsageError::EmPresetUsageError();
+    return 1;
+  }
+
   G4GDMLParser parser;
   parser.Read("TileTB_2B1EB_nobeamline.gdml", false);
-  runManager->SetUserInitialization(new ATLTileCalTBDetConstruction(parser));
+  runManager->SetUserInitialization(new ATLTileCalTBDetConstruction(parser, user_limits));
 
   // Classes via ActionInitialization
   //
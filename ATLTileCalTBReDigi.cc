@@ -0,0 +1,219 @@
+//**************************************************
+// \file ATLTileCalTBReDigi.cc
+// \brief: main() of ATLTileCalTBReDigi, offline
+//         re-digitization of the step records
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Replays the raw scintillator deposits written by ATLTileCalTB
+// (built with WITH_ATLTileCalTB_StepRecord=ON) through the
+// digitization chain (Birk's law -> photoelectrons -> U-shape ->
+// PMT response -> noise) without the Geant4 transport. The output
+// ntuple has the same layout as the ATLTileCalTB one.
+
+// Includers from project files
+//
+#include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBDigitization.hh"
+#include "ATLTileCalTBDigitizer.hh"
+#include "ATLTileCalTBGeometry.hh"
+#include "ATLTileCalTBNtuple.hh"
+#include "ATLTileCalTBRandomBuffer.hh"
+#include "ATLTileCalTBSignalBuffer.hh"
+#include "ATLTileCalTBStepRecord.hh"
+
+// Includers from Geant4
+//
+#include "G4SystemOfUnits.hh"
+#include "G4UIcommand.hh"
+#include "G4Version.hh"
+#include "Randomize.hh"
+#if G4VERSION_NUMBER < 1100
+#include "g4root.hh" // replaced by G4AnalysisManager.h  in G4 v11 and up
+#else
+#include "G4AnalysisManager.hh"
+#endif
+
+// Includers from C++
+//
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+// CLI string outputs
+namespace CLIOutputs {
+void PrintHelp() {
+  G4cout << "Usage: ATLTileCalTBReDigi [OPTION...]\n\n"
+         << "Options:\n"
+         << "  -i INPUT        step record file (can be repeated)\n"
+         << "  -o OUTPUT       output root file (default ATLTileCalTBout_ReDigi.root)\n"
+         << "  -s SEED         seed of the random engine\n"
+         << "  -n              disable the electronic noise\n"
+         << "  -p PRESET       time binning of the signal (nominal, coarse, short)\n"
+         << "  -r              write the sampled readout and optimal filter reconstruction\n"
+         << "  -v              write the digitization variants (Sdep_<name> and SdepSum_<name>)\n"
+         << "  -h              print this help and exit\n"
+         << G4endl;
+}
+void PrintError() {
+  G4cerr << "Wrong usage, see 'ATLTileCalTBReDigi -h' for more information" << G4endl;
+}
+} // namespace CLIOutputs
+
+int main(int argc, char **argv) {
+
+  // CLI variables
+  std::vector<G4String> inputs;
+  G4String output = "ATLTileCalTBout_ReDigi.root";
+  G4String presetName = ATLTileCalTBConstants::digi_presets.front().name;
+
+  // CLI parsing
+  G4bool noise = true;
+  G4bool sampledReadout = false;
+  G4bool digiVariants = false;
+  for (G4int i = 1; i < argc; ++i) {
+    const G4String option = argv[i];
+    if (option == "-h") {
+      CLIOutputs::PrintHelp();
+      return 0;
+    } else if (option == "-n")
+      noise = false;
+    else if (option == "-r")
+      sampledReadout = true;
+    else if (option == "-v")
+      digiVariants = true;
+    else if (i + 1 >= argc) {
+      CLIOutputs::PrintError();
+      return 1;
+    } else if (option == "-i")
+      inputs.push_back(argv[++i]);
+    else if (option == "-o")
+      output = argv[++i];
+    else if (option == "-p")
+      presetName = argv[++i];
+    else if (option == "-s")
+      G4Random::setTheSeed(G4UIcommand::ConvertToInt(argv[++i]));
+    else {
+      CLIOutputs::PrintError();
+      return 1;
+    }
+  }
+  const auto &presets = ATLTileCalTBConstants::digi_presets;
+  const auto preset = std::find_if(presets.begin(), presets.end(),
+                                   [&presetName](const auto &p) { return presetName == p.name; });
+  if (inputs.empty() || preset == presets.end()) {
+    CLIOutputs::PrintError();
+    return 1;
+  }
+
+  // Time binning of the signal (the step records use the nominal one)
+  //
+  const std::size_t noOfCells = ATLTileCalTBGeometry::CellLUT::GetNumberOfCells();
+  ATLTileCalTBSignalBuffer signalBuffer;
+  signalBuffer.SetLayout(preset->bin_time, preset->time_window);
+  const std::size_t frames = signalBuffer.GetFrames();
+  ATLTileCalTBDigitizer digitizer(ATLTileCalTBDigitization::GetPMTResponse(1., preset->bin_time), frames);
+
+  // Create ntuple (same class as in ATLTileCalTB)
+  //
+  ATLTileCalTBNtuple ntuple;
+  ntuple.SetLayout(preset->bin_time, frames);
+  ntuple.SetSampledReadout(sampledReadout);
+  ntuple.SetDigiVariants(digiVariants);
+  ntuple.SetNoise(noise);
+  auto &edepVector = ntuple.GetEdepVector();
+  auto &sdepVector = ntuple.GetSdepVector();
+
+  auto analysisManager = G4AnalysisManager::Instance();
+  analysisManager->SetVerboseLevel(1);
+#if G4VERSION_NUMBER > 1050
+  analysisManager->SetNtupleRowWise(false);
+#endif
+  ntuple.Book();
+  analysisManager->OpenFile(output);
+
+  // Replay events
+  //
+  auto randomBuffer = ATLTileCalTBRandomBuffer::GetInstance();
+  std::vector<ATLTileCalTBStepRecord> records;
+  std::size_t noOfEvents = 0;
+
+  for (const auto &input : inputs) {
+    std::ifstream ifs(input, std::ios::binary);
+    ATLTileCalTBStepRecordHeader header{};
+    if (!ifs.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        !ATLTileCalTBStepRecordFile::IsValidHeader(header)) {
+      G4cerr << "Not a valid step record file: " << input << G4endl;
+      return 1;
+    }
+
+    ATLTileCalTBStepRecordEvent event{};
+    while (ifs.read(reinterpret_cast<char *>(&event), sizeof(event))) {
+      records.resize(event.nRecords);
+      if (!ifs.read(reinterpret_cast<char *>(records.data()),
+                    records.size() * sizeof(ATLTileCalTBStepRecord))) {
+        G4cerr << "Truncated event " << event.eventID << " in " << input << G4endl;
+        return 1;
+      }
+
+      // Same chain as in ATLTileCalTBSensDet::ProcessHits()
+      signalBuffer.Reset();
+      randomBuffer->Reset();
+      std::fill(edepVector.begin(), edepVector.end(), 0.);
+      for (const auto &record : records) {
+        // the records cover the nominal time window, the hits the one of the preset
+        const std::size_t bin = signalBuffer.GetBin(record.timeBin * ATLTileCalTBConstants::frame_bin_time);
+        if (bin >= frames)
+          continue;
+        edepVector[record.cellIndex] += record.edep * record.weight;
+
+        // the deposits of the fast simulation models are already visible energies
+        G4double sdep = (record.flags & ATLTileCalTBStepRecordFile::fastDeposit)
+                            ? record.edep
+                            : ATLTileCalTBDigitization::BirkLaw(record.edep * record.weight, record.stepLength,
+                                                                record.charge, record.density);
+        sdep = ATLTileCalTBDigitization::GetPhotoelectrons(sdep, *randomBuffer);
+        const auto uShape = ATLTileCalTBDigitization::Tile_1D_profileRescaled(record.profileRow, record.yLocal,
+                                                                              record.zLocal, record.cellIndex);
+        signalBuffer.AddSdep(record.cellIndex, bin, sdep * uShape.up, sdep * uShape.down);
+      }
+
+      // Same chain as in ATLTileCalTBEventAction::EndOfEventAction()
+      for (std::size_t n = 0; n < noOfCells; ++n) {
+        const std::size_t begin = signalBuffer.GetBeginBin(n);
+        const std::size_t end = signalBuffer.GetEndBin(n);
+        if (begin == end) {
+          sdepVector[n] = noise ? ATLTileCalTBDigitization::GetNoiseSignal(*randomBuffer) : 0.;
+          continue;
+        }
+        const G4double peakUp = digitizer.GetPeak(signalBuffer.GetSdepUp(n), begin, end);
+        const G4double peakDown = digitizer.GetPeak(signalBuffer.GetSdepDown(n), begin, end);
+        sdepVector[n] =
+            noise ? ATLTileCalTBDigitization::GetCellSignal(peakUp, peakDown, *randomBuffer) : peakUp + peakDown;
+      }
+
+      // Digitization variants, sampled readout and ntuple row
+      auto cellSignal = [&signalBuffer](std::size_t n) {
+        return ATLTileCalTBNtuple::CellSignal{signalBuffer.GetSdepUp(n), signalBuffer.GetSdepDown(n),
+                                              signalBuffer.GetBeginBin(n), signalBuffer.GetEndBin(n)};
+      };
+      ntuple.DigitizeVariants(cellSignal, *randomBuffer);
+      ntuple.ReadoutCells(cellSignal, digitizer, noise ? ATLTileCalTBConstants::signal_noise_sigma : 0., *randomBuffer);
+      ntuple.Fill(event.eLeak, event.eCal, event.eLate, event.pdgID, event.eBeam);
+      noOfEvents++;
+    }
+  }
+
+  analysisManager->Write();
+  analysisManager->CloseFile();
+#if G4VERSION_NUMBER < 1100
+  delete G4AnalysisManager::Instance(); // not needed for G4 v11 and up
+#endif
+
+  G4cout << "Re-digitized " << noOfEvents << " events into " << output << G4endl;
+  return 0;
+}
+
+//**************************************************
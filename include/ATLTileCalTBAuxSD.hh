@@ -0,0 +1,56 @@
+//**************************************************
+// \file ATLTileCalTBAuxSD.hh
+// \brief: definition of ATLTileCalTBAuxSD class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Scoring of the auxiliary data of ATLTileCalTBEventAction
+// (no hits collection) in the volumes it is assigned to:
+// the energy deposited (Ecal) if assigned to the absorber and
+// passive volumes, the kinetic energy leaving the world (ELeak)
+// if assigned to the world volume. The scintillator energy
+// is added to Ecal by ATLTileCalTBSensDet.
+
+#ifndef ATLTileCalTBAuxSD_h
+#define ATLTileCalTBAuxSD_h 1
+
+//Includers from Geant4
+//
+#include "G4VSensitiveDetector.hh"
+
+//Forward declaration from project
+//
+class ATLTileCalTBEventAction;
+
+//Forward declaration from Geant4
+//
+class G4Step;
+class G4HCofThisEvent;
+
+class ATLTileCalTBAuxSD : public G4VSensitiveDetector {
+
+    public:
+        enum class Quantity {
+            LEAKAGE,   //ELeak, world volume
+            ENERGY,    //Ecal, absorber and passive volumes
+        };
+
+        ATLTileCalTBAuxSD( const G4String& name, Quantity quantity );
+        virtual ~ATLTileCalTBAuxSD();
+
+        //Methods from base class
+        //
+        virtual void Initialize( G4HCofThisEvent* hitCollection );
+        virtual G4bool ProcessHits( G4Step* aStep, G4TouchableHistory* history );
+
+    private:
+        Quantity fQuantity;
+        ATLTileCalTBEventAction* fEventAction;
+
+};
+
+#endif //ATLTileCalTBAuxSD_h 1
+
+//**************************************************
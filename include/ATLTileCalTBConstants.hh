@@ -46,6 +46,26 @@ namespace ATLTileCalTBConstants {
     // Digitization: amount of early time frames
     constexpr std::size_t frames = static_cast<std::size_t>(frame_time_window / frame_bin_time);
 
+    // Digitization: presets of the time binning selectable per run (/tiletb/digi/preset),
+    // their number of frames can not exceed the nominal one
+    struct DigiPreset {
+        const char* name;
+        G4double bin_time;
+        G4double time_window;
+    };
+    constexpr std::array<DigiPreset, 3> digi_presets {{
+        {"nominal", frame_bin_time, frame_time_window},
+        {"coarse", 1. * ns, frame_time_window},
+        {"short", frame_bin_time, 200. * ns},
+    }};
+
+    // Digitization: floating point type used to accumulate the binned signal
+    #ifdef ATLTileCalTB_FloatSignal
+    using signal_t = G4float;
+    #else
+    using signal_t = G4double;
+    #endif
+
     // Digitization: analog response of the PMT to one photoelectron (0.5ns bins)
     // From https://gitlab.cern.ch/atlas/athena/-/blob/1a58a6b7cc3d6e02c664814502796aa9f86eab7c/TileCalorimeter/TileConditions/share/pulsehi_physics.dat
     constexpr std::array<G4double, 401> pmt_response {
@@ -452,6 +472,77 @@ namespace ATLTileCalTBConstants {
         0.00185470,
     };
 
+    // Digitization: additional variants of the digitization of the same hits,
+    // written as Sdep_<name> and SdepSum_<name> (/tiletb/digi/variants, ATLTileCalTBReDigi -v)
+    struct DigiVariant {
+        const char* name;
+        G4double noise_sigma;     // electronic noise sigma per PMT (0 disables noise and cut)
+        G4double cut_multiple;    // cell signal kept if above cut_multiple * noise_sigma
+        G4double kernel_stretch;  // time stretch of pmt_response (1 for the nominal one)
+        G4double time_window;     // signal after time_window is not digitized
+    };
+    constexpr std::array<DigiVariant, 3> digi_variants {{
+        {"NoNoise", 0., 0., 1., frame_time_window},
+        {"Cut3Sigma", signal_noise_sigma, 3., 1., frame_time_window},
+        {"Window100ns", signal_noise_sigma, 2., 1., 100 * ns},
+    }};
+
+    // Digitization: sampled readout as in the ATLAS TileCal front-end (/tiletb/output/samples),
+    // readout_samples samples per PMT every readout_sample_period, the central one at the
+    // peak of the PMT response to a signal at t = 0
+    constexpr std::size_t readout_samples = 7;
+    constexpr G4double readout_sample_period = 25. * ns;
+
+    // Digitization: phases of the optimal filter weights table (-readout_max_phase to readout_max_phase)
+    constexpr G4double readout_max_phase = 25. * ns;
+    constexpr G4double readout_phase_step = 0.5 * ns;
+
+    // Clustering: topological clustering of the cell signals (Cluster columns), thresholds
+    // on the absolute cell signal in units of the cell noise sigma (sqrt(2) * signal_noise_sigma),
+    // not applied without noise
+    constexpr G4double cluster_seed_threshold = 4.;
+    constexpr G4double cluster_grow_threshold = 2.;
+    constexpr G4double cluster_terminal_threshold = 0.;
+
+    // Tracking: tracks are killed once their global time exceeds the time window of the signal
+    // plus late_track_margin (/tiletb/tracking/timeCut), their kinetic energy is written as ELate
+    constexpr G4double late_track_margin = 50. * ns;
+    // Tracking: default time limit of the neutron killer of the physics lists (G4NeutronTrackingCut)
+    constexpr G4double neutron_killer_time_limit = 10. * microsecond;
+    // Tracking: particles killed at creation with their energy written as ELeak, as they leave
+    // the world without interacting (/tiletb/tracking/nonInteracting)
+    constexpr std::array<const char*, 6> non_interacting_particles {{
+        "nu_e", "anti_nu_e", "nu_mu", "anti_nu_mu", "nu_tau", "anti_nu_tau" }};
+
+    // Shower library: kinetic energy range of the e+-/gamma replaced by a library entry
+    // (the upper limit can be lowered with /tiletb/library/maxEnergy), logarithmic bins
+    constexpr G4double shower_library_min_energy = 1. * MeV;
+    constexpr G4double shower_library_max_energy = 1. * GeV;
+    constexpr std::size_t shower_library_energy_bins = 12;
+    // Shower library: bins of the start position along the period axis
+    constexpr std::size_t shower_library_phase_bins = 4;
+    // Shower library: entries per bin written in generation mode
+    constexpr std::size_t shower_library_max_entries = 100;
+
+    // Parameterized EM showers: minimum kinetic energy of the primary e+- replaced by
+    // energy spots, energy of a spot and dE/dx of the spots in the scintillator (Birk's law)
+    constexpr G4double em_shower_min_energy = 1. * GeV;
+    constexpr G4double em_shower_spot_energy = 10. * MeV;
+    constexpr G4double em_shower_spot_dedx = 2. * MeV / cm;
+    // Parameterized EM showers: default profile (/tiletb/emShower/parameters), mean depth
+    // and median radius in mm, gamma shape of the depth, all linear in ln(E/GeV), and
+    // fraction of the calo energy deposited in the scintillator
+    struct EmShowerParameters {
+        G4double depth0;
+        G4double depth1;
+        G4double shape0;
+        G4double shape1;
+        G4double radius0;
+        G4double radius1;
+        G4double sampling_fraction;
+    };
+    constexpr EmShowerParameters em_shower_parameters { 111., 24., 2.65, 0.5, 10., 0., sampling_fraction };
+
 }
 
 #endif //ATLTileCalTBConstants_h
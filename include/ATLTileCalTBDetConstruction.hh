@@ -13,23 +13,47 @@
 //Includers from Geant4
 //
 #include "G4VUserDetectorConstruction.hh"
+#include "globals.hh"
+
+//Forward declaration from project
+//
+class ATLTileCalTBDetMessenger;
 
 //Forward declaration from Geant4
 //
 class G4GDMLParser;
 class G4VPhysicalVolume;
+class G4Region;
 
 class ATLTileCalTBDetConstruction : public G4VUserDetectorConstruction {
     
     public:
-        ATLTileCalTBDetConstruction  (const G4GDMLParser& parser);
+        //userLimits: G4StepLimiterPhysics is registered (ATLTileCalTB -l 1),
+        //needed by the user limits of the regions
+        ATLTileCalTBDetConstruction  (const G4GDMLParser& parser, G4bool userLimits = false);
         ~ATLTileCalTBDetConstruction ();
         virtual G4VPhysicalVolume* Construct();
         virtual void ConstructSDandField();
 
+        //Production cut (particle "all" for all of them) and user limits
+        //of a calorimeter region (ATLTileCalTBGeometry::region_names)
+        void SetRegionCut( const G4String& regionName, const G4String& particle, G4double cut );
+        void SetRegionMinEkin( const G4String& regionName, G4double minEkin );
+        void SetRegionMaxTime( const G4String& regionName, G4double maxTime );
+
+        //Gamma general process with Woodcock tracking in a single calorimeter
+        //region (ATLTileCalTBGeometry::calo_region_name), before initialization
+        void SetWoodcock( G4bool woodcock );
+        G4bool GetWoodcock() const { return fWoodcock; }
+
     private:
         const G4GDMLParser& fParser;
+        ATLTileCalTBDetMessenger* fMessenger;
+        G4bool fUserLimits;
+        G4bool fWoodcock;
         void DefineVisAttributes();
+        void DefineRegions();
+        G4Region* GetRegion( const G4String& regionName ) const;
 
 };
 
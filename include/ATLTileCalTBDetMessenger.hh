@@ -0,0 +1,56 @@
+//**************************************************
+// \file ATLTileCalTBDetMessenger.hh
+// \brief: definition of ATLTileCalTBDetMessenger
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// UI commands setting the production cuts and user limits
+// of the calorimeter regions and the Woodcock tracking of
+// the photons in the calorimeter (/tiletb/region/). The regions
+// are shared by all threads, the commands are only executed
+// on the master.
+
+#ifndef ATLTileCalTBDetMessenger_h
+#define ATLTileCalTBDetMessenger_h 1
+
+//Includers from Geant4
+//
+#include "G4UImessenger.hh"
+
+//Forward declaration from project
+//
+class ATLTileCalTBDetConstruction;
+
+//Forward declaration from Geant4
+//
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+
+class ATLTileCalTBDetMessenger : public G4UImessenger {
+
+    public:
+        ATLTileCalTBDetMessenger( ATLTileCalTBDetConstruction* detConstruction );
+        virtual ~ATLTileCalTBDetMessenger();
+
+        virtual void SetNewValue( G4UIcommand* command, G4String newValue );
+        virtual G4String GetCurrentValue( G4UIcommand* command );
+
+    private:
+        ATLTileCalTBDetConstruction* fDetConstruction;
+
+        G4UIdirectory* fRegionDir;
+
+        G4UIcommand* fCutCmd;
+        G4UIcommand* fMinEkinCmd;
+        G4UIcommand* fMaxTimeCmd;
+        G4UIcmdWithABool* fWoodcockCmd;
+
+};
+
+#endif //ATLTileCalTBDetMessenger_h
+
+//**************************************************
@@ -0,0 +1,146 @@
+//**************************************************
+// \file ATLTileCalTBDigiPipeline.hh
+// \brief: definition of ATLTileCalTBDigiPipeline
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Digitization of the events of a worker thread on a few
+// digitization threads, so that the worker goes back to the
+// transport right after copying the binned signal of the cells
+// it touched. The events are queued in submission order and at
+// most fMaxEvents events (or fMaxBytes of binned signal) are in
+// flight, the worker waits for the oldest one otherwise.
+// Completed events are handed back to the worker (in order) to
+// fill the ntuple, as the analysis manager is per worker thread.
+// The noise of each event is sampled on the digitization thread
+// (own engine) from a seed of the run seed and the event ID, the
+// output is reproducible and does not depend on the transport,
+// but it is not the same as with the digitization on the worker.
+// One instance per worker thread and run.
+
+#ifndef ATLTileCalTBDigiPipeline_h
+#define ATLTileCalTBDigiPipeline_h 1
+
+//Includers from project files
+//
+#include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBDigitizer.hh"
+#include "ATLTileCalTBOptimalFilter.hh"
+
+//Includers from Geant4
+//
+#include "G4Types.hh"
+
+//Includers from C++
+//
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ATLTileCalTBDigiPipeline {
+
+    public:
+        //Copy of an event to be digitized and its cell signals
+        struct Event {
+            //Filled by the worker
+            G4double eLeak;
+            G4double eCal;
+            G4double eLate;
+            G4int pdgID;
+            G4double eBeam;
+            G4int eventID;
+            std::vector<G4double> edep;
+            //Filled time bins of the touched cells, [offset, offset + end - begin)
+            //for the up PMT followed by the same range for the down PMT
+            std::vector<std::size_t> cells;
+            std::vector<std::size_t> beginBins;
+            std::vector<std::size_t> endBins;
+            std::vector<std::size_t> offsets;
+            std::vector<ATLTileCalTBConstants::signal_t> signal;
+
+            //Filled by the digitization thread
+            std::vector<G4double> sdep;
+            std::vector<std::vector<G4double>> variantSdep;
+            std::vector<G4float> samples;
+            std::vector<G4double> ofAmplitude;
+            std::vector<G4double> ofTime;
+            G4bool done;
+
+            //Copy the filled time bins [begin, end) of the two PMTs of a cell
+            void AddCell( std::size_t cellIndex, const ATLTileCalTBConstants::signal_t* sdepUp,
+                          const ATLTileCalTBConstants::signal_t* sdepDown, std::size_t begin, std::size_t end );
+        };
+        using FlushFunction = std::function<void( const Event& )>;
+
+        //Digitization threads using copies of the given digitizers (nominal
+        //and digitization variants with their time windows), the sampled
+        //readout is only done if an optimal filter is given
+        ATLTileCalTBDigiPipeline( std::size_t noOfThreads, G4long runSeed, const ATLTileCalTBDigitizer& digitizer, G4bool noise,
+                                  const ATLTileCalTBOptimalFilter* optimalFilter,
+                                  const std::vector<ATLTileCalTBDigitizer>& variantDigitizers = {},
+                                  const std::vector<std::size_t>& variantWindowBins = {} );
+        //Waits for the queued events (they are discarded if not flushed)
+        ~ATLTileCalTBDigiPipeline();
+
+        ATLTileCalTBDigiPipeline(ATLTileCalTBDigiPipeline const&) = delete;
+        void operator=(ATLTileCalTBDigiPipeline const&) = delete;
+
+        //Free (cleared) event to be filled by the worker and submitted,
+        //waits for (and flushes) the oldest events if the pipeline is full
+        Event& Acquire( const FlushFunction& flush );
+        void Submit( Event& event );
+
+        //Flush the completed events in submission order, Finish() waits for all of them
+        void Flush( const FlushFunction& flush );
+        void Finish( const FlushFunction& flush );
+
+        //Seed from a seed and an index (e.g. run seed and event ID), the
+        //nearby inputs give unrelated seeds
+        static G4long GetSeed( G4long seed, G4long index );
+
+        //Maximum number of events and of bytes of binned signal in flight
+        static constexpr std::size_t fMaxEvents = 64;
+        static constexpr std::size_t fMaxBytes = 64 * 1024 * 1024;
+
+    private:
+        //Digitization thread loop
+        void Run();
+        //Flush the oldest event if completed (or wait for it), the lock is released while flushing
+        G4bool FlushFront( std::unique_lock<std::mutex>& lock, G4bool wait, const FlushFunction& flush );
+
+        static std::size_t GetBytes( const Event& event );
+
+        //Seed of the run, digitizer prototypes (copied by each thread), noise mode and optimal filter
+        G4long fRunSeed;
+        ATLTileCalTBDigitizer fDigitizer;
+        G4bool fNoise;
+        std::unique_ptr<ATLTileCalTBOptimalFilter> fOptimalFilter;
+        std::vector<ATLTileCalTBDigitizer> fVariantDigitizers;
+        std::vector<std::size_t> fVariantWindowBins;
+
+        std::vector<std::unique_ptr<Event>> fEvents;
+        std::vector<Event*> fFreeEvents;
+        //Submitted events (in order) and events not yet picked by a thread
+        std::deque<Event*> fInFlight;
+        std::deque<Event*> fQueue;
+        std::size_t fBytesInFlight;
+        std::size_t fNoOfCells;
+
+        std::mutex fMutex;
+        std::condition_variable fQueueCondition;
+        std::condition_variable fDoneCondition;
+        G4bool fStop;
+        std::vector<std::thread> fThreads;
+
+};
+
+#endif //ATLTileCalTBDigiPipeline_h
+
+//**************************************************
@@ -0,0 +1,79 @@
+//**************************************************
+// \file ATLTileCalTBDigitization.hh
+// \brief: definition of ATLTileCalTBDigitization
+//         namespace
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Digitization chain of the scintillator signal
+// (Birk's law -> photoelectrons -> U-shape -> PMT response -> noise).
+// It does not depend on the Geant4 transport and it is shared by
+// the sensitive detector, the event action and ATLTileCalTBReDigi.
+
+#ifndef ATLTileCalTBDigitization_h
+#define ATLTileCalTBDigitization_h 1
+
+//Includers from project files
+//
+#include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBGeometry.hh"
+#include "ATLTileCalTBRandomBuffer.hh"
+
+//Includers from Geant4
+//
+#include "G4Types.hh"
+
+//Includers from C++
+//
+#include <array>
+#include <vector>
+
+namespace ATLTileCalTBDigitization {
+
+    //Pulse of a PMT after the convolution with its response
+    //(sized for the nominal binning, the other presets use less frames)
+    using Pulse = std::array<G4double, ATLTileCalTBConstants::frames>;
+
+    //Visible energy after Birk's saturation law
+    //(destep already multiplied by the track weight)
+    G4double BirkLaw( G4double destep, G4double stepLength, G4double charge, G4double density );
+
+    //Number of photoelectrons (Poisson distributed) from the visible energy
+    G4double GetPhotoelectrons( G4double visibleEnergy, ATLTileCalTBRandomBuffer& random );
+
+    //Fraction of the signal collected by the two PMTs of a cell
+    //as a function of the local coordinates in the scintillator
+    struct UShapeResponse {
+        G4double up;
+        G4double down;
+    };
+    UShapeResponse Tile_1D_profileRescaled( G4int row, G4double x, G4double y, std::size_t cellIndex/*, G4int nSide*/ );
+
+    //Cell signal from the pulse peaks of its two PMTs (+ electronic noise),
+    //the pulses are computed by ATLTileCalTBDigitizer
+    G4double GetCellSignal( G4double peakUp, G4double peakDown, ATLTileCalTBRandomBuffer& random );
+
+    //Cell signal of a cell without deposits (electronic noise only),
+    //same distribution as GetCellSignal(0., 0., random)
+    G4double GetNoiseSignal( ATLTileCalTBRandomBuffer& random );
+
+    //Same as above with a given noise sigma and cut (in units of sigma)
+    G4double GetCellSignal( G4double peakUp, G4double peakDown, G4double noiseSigma, G4double cutMultiple,
+                            ATLTileCalTBRandomBuffer& random );
+    G4double GetNoiseSignal( G4double noiseSigma, G4double cutMultiple, ATLTileCalTBRandomBuffer& random );
+
+    //PMT response stretched in time by a factor stretch and sampled
+    //every binTime (linear interpolation)
+    std::vector<G4double> GetPMTResponse( G4double stretch, G4double binTime = ATLTileCalTBConstants::frame_bin_time );
+
+    //Number of time bins of width binTime before timeWindow (at most frames)
+    std::size_t GetWindowBins( G4double timeWindow, G4double binTime = ATLTileCalTBConstants::frame_bin_time,
+                               std::size_t frames = ATLTileCalTBConstants::frames );
+
+}
+
+#endif //ATLTileCalTBDigitization_h
+
+//**************************************************
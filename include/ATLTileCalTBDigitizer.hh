@@ -0,0 +1,127 @@
+//**************************************************
+// \file ATLTileCalTBDigitizer.hh
+// \brief: definition of ATLTileCalTBDigitizer
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Convolution of the binned signal of a PMT with its response.
+// For every pulse the cheapest of three methods is used:
+//  - SPARSE: shift-and-add of the kernel over the non-empty bins,
+//  - DIRECT: shift-and-add over all the bins of the filled range
+//            (contiguous inner loop, vectorized by the compiler),
+//  - FFT:    overlap-add with the precomputed FFT of the kernel.
+// SPARSE and DIRECT give the same result as the textbook convolution.
+// GetPeak() returns the maximum of the pulse and only evaluates
+// the samples that can contain it, as the binned signal is positive.
+// One instance per thread (it holds scratch buffers).
+
+#ifndef ATLTileCalTBDigitizer_h
+#define ATLTileCalTBDigitizer_h 1
+
+//Includers from project files
+//
+#include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBDigitization.hh"
+
+//Includers from Geant4
+//
+#include "G4Types.hh"
+
+//Includers from C++
+//
+#include <complex>
+#include <vector>
+
+class ATLTileCalTBDigitizer {
+
+    public:
+        enum class Method {
+            AUTO,
+            SPARSE,
+            DIRECT,
+            FFT,
+        };
+
+        //Digitizer with the nominal PMT response and binning or with a given
+        //PMT response (sampled with the bin width of the signal) and number of frames
+        ATLTileCalTBDigitizer();
+        explicit ATLTileCalTBDigitizer( const std::vector<G4double>& kernel,
+                                        std::size_t frames = ATLTileCalTBConstants::frames );
+        ~ATLTileCalTBDigitizer() = default;
+
+        //Force a convolution method (AUTO picks the cheapest per pulse)
+        void SetMethod( Method method ) { fMethod = method; }
+        Method GetMethod() const { return fMethod; }
+        std::size_t GetFrames() const { return fFrames; }
+
+        //Convolution of the binned signal (GetFrames() values, filled in [begin, end))
+        //with the PMT response, the pulse is 0 after GetFrames()
+        void ConvolutePMT( const ATLTileCalTBConstants::signal_t* sdep, std::size_t begin, std::size_t end,
+                           ATLTileCalTBDigitization::Pulse& pulse );
+
+        //Maximum of the convolution (0 for an empty signal)
+        G4double GetPeak( const ATLTileCalTBConstants::signal_t* sdep, std::size_t begin, std::size_t end );
+
+        //Pulse at given positions in units of time bins (linear interpolation
+        //between the samples of the convolution), 0 after GetFrames()
+        void GetSamples( const ATLTileCalTBConstants::signal_t* sdep, std::size_t begin, std::size_t end,
+                         const G4double* positions, std::size_t count, G4double* samples );
+
+        //Cell signal (peaks + electronic noise) from the binned signal of its two PMTs,
+        //noise only if [begin, end) is empty
+        G4double GetCellSignal( const ATLTileCalTBConstants::signal_t* sdepUp, const ATLTileCalTBConstants::signal_t* sdepDown,
+                                std::size_t begin, std::size_t end, G4double noiseSigma, G4double cutMultiple,
+                                ATLTileCalTBRandomBuffer& random );
+
+    private:
+        //Fill the list of non-empty bins in [begin, end)
+        void GatherBins( const ATLTileCalTBConstants::signal_t* sdep, std::size_t begin, std::size_t end );
+        //Estimated cost (multiply-adds) of the full convolution and cheapest method
+        Method SelectMethod( std::size_t begin, std::size_t end, G4double& cost ) const;
+
+        void ConvoluteSparse( ATLTileCalTBDigitization::Pulse& pulse ) const;
+        void ConvoluteDirect( const ATLTileCalTBConstants::signal_t* sdep, std::size_t begin, std::size_t end,
+                              ATLTileCalTBDigitization::Pulse& pulse ) const;
+        void ConvoluteFFT( const ATLTileCalTBConstants::signal_t* sdep, std::size_t begin, std::size_t end,
+                           ATLTileCalTBDigitization::Pulse& pulse );
+
+        //Single sample of the convolution from the non-empty bins
+        G4double EvaluateSample( std::size_t k ) const;
+
+        //In-place radix-2 FFT of size fFFTSize
+        void FFT( std::vector<std::complex<G4double>>& data, G4bool inverse ) const;
+
+        static std::size_t GetFFTSize( std::size_t kernelSize );
+
+        //PMT response, number of frames, FFT size and input block length of the overlap-add
+        std::vector<G4double> fKernel;
+        std::size_t fFrames;
+        std::size_t fKernelSize;
+        std::size_t fFFTSize;
+        std::size_t fBlockSize;
+
+        Method fMethod;
+
+        //Kernel position of the maximum, running maximum from the left and from the right
+        std::size_t fKernelPeak;
+        std::vector<G4double> fKernelPrefixMax;
+        std::vector<G4double> fKernelSuffixMax;
+
+        //FFT of the kernel, twiddle factors and bit reversal permutation
+        std::vector<std::complex<G4double>> fKernelFFT;
+        std::vector<std::complex<G4double>> fTwiddles;
+        std::vector<std::size_t> fBitReverse;
+
+        //Scratch buffers
+        std::vector<std::complex<G4double>> fFFTBuffer;
+        std::vector<std::size_t> fBins;
+        std::vector<G4double> fValues;
+
+};
+
+#endif //ATLTileCalTBDigitizer_h
+
+//**************************************************
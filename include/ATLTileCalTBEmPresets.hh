@@ -0,0 +1,45 @@
+//**************************************************
+// \file ATLTileCalTBEmPresets.hh
+// \brief: definition of ATLTileCalTBEmPresets
+//         namespace
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Named sets of G4EmParameters trading the accuracy of the
+// electromagnetic physics for speed (multiple scattering step
+// limitation, lowest electron energy, gamma general process,
+// energy loss fluctuations), applied on top of the physics list
+// before /run/initialize (ATLTileCalTB -e or /tiletb/physics/emPreset).
+// The applied preset is written to the RunInfo ntuple.
+
+#ifndef ATLTileCalTBEmPresets_h
+#define ATLTileCalTBEmPresets_h 1
+
+//Includers from Geant4
+//
+#include "globals.hh"
+
+//Includers from C++
+//
+#include <vector>
+
+namespace ATLTileCalTBEmPresets {
+
+    //Names of the presets, "default" keeps the settings of the physics list
+    std::vector<G4String> GetNames();
+
+    //Apply a preset to G4EmParameters on top of the physics list settings
+    //(saved at the first call, restored by every call), false if there is
+    //no preset with this name
+    G4bool Apply( const G4String& name );
+
+    //Name of the last applied preset
+    const G4String& GetActive();
+
+}
+
+#endif //ATLTileCalTBEmPresets_h
+
+//**************************************************
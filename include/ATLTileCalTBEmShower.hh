@@ -0,0 +1,168 @@
+//**************************************************
+// \file ATLTileCalTBEmShower.hh
+// \brief: definition of ATLTileCalTBEmShower
+//         classes
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Profile of the parameterized (GFlash-like) EM showers of the
+// primary e+- used by ATLTileCalTBEmShowerModel: the depth of the
+// energy spots along the primary direction follows a gamma
+// distribution and their radius the GFlash radial profile
+// 2 r R^2 / (r^2 + R^2)^2 of median radius R. The parameters are
+// linear in ln(E/GeV) and are fitted to full-sim showers by
+// ATLTileCalTBEmShowerTuner (/tiletb/emShower/tune).
+// Only built with the ATLTileCalTB_FastSim compiler definition.
+
+#ifndef ATLTileCalTBEmShower_h
+#define ATLTileCalTBEmShower_h 1
+
+//Includers from project files
+//
+#include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBPeriodLayouts.hh"
+
+//Includers from Geant4
+//
+#include "G4Types.hh"
+#include "G4ThreeVector.hh"
+#include "G4ThreadLocalSingleton.hh"
+
+//Includers from C++
+//
+#include <array>
+#include <memory>
+#include <vector>
+
+//Forward declaration from Geant4
+//
+class G4VTouchable;
+
+//Settings of the parameterized showers, set by the master thread
+//and shared (read-only) by the models of all threads
+//
+class ATLTileCalTBEmShower {
+
+    public:
+        using Parameters = ATLTileCalTBConstants::EmShowerParameters;
+
+        //Return pointer to class instance
+        static ATLTileCalTBEmShower* GetInstance() {
+            static ATLTileCalTBEmShower instance{};
+            return &instance;
+        }
+
+        void SetEnabled( G4bool enabled ) { fEnabled = enabled; }
+        G4bool IsEnabled() const { return fEnabled; }
+        void SetParameters( const Parameters& parameters ) { fParameters = parameters; }
+        const Parameters& GetParameters() const { return fParameters; }
+
+        //Mean depth, gamma shape and median radius of a shower
+        //
+        struct Profile {
+            G4double depth;
+            G4double shape;
+            G4double radius;
+        };
+        Profile GetProfile( G4double energy ) const;
+
+    private:
+        //Private constructor
+        ATLTileCalTBEmShower();
+
+        G4bool fEnabled;
+        Parameters fParameters;
+
+    public:
+        ATLTileCalTBEmShower(ATLTileCalTBEmShower const&) = delete;
+        void operator=(ATLTileCalTBEmShower const&) = delete;
+
+};
+
+//Per-thread moments of the full-sim showers of the primary e+- (tuning
+//mode), from the point where ATLTileCalTBEmShowerModel would replace
+//them. The sampling fraction is the scintillator energy over the energy
+//in the periods, the volumes where the model gives signal. The sums of
+//the threads are merged at the end of the run and the parameters are
+//fitted by the master thread
+//
+class ATLTileCalTBEmShowerTuner {
+
+    friend class G4ThreadLocalSingleton<ATLTileCalTBEmShowerTuner>;
+
+    public:
+        //Return pointer to class instance
+        static ATLTileCalTBEmShowerTuner* GetInstance() {
+            static G4ThreadLocalSingleton<ATLTileCalTBEmShowerTuner> instance{};
+            return instance.Instance();
+        }
+
+        //Run-wise methods
+        //
+        //The period layouts are built when first activated (geometry must be constructed)
+        void SetActive( G4bool active );
+        G4bool IsActive() const { return fActive; }
+        //Add the sums of this thread to the ones of the run
+        void Merge();
+        //Fit the parameters to the sums of the run, print them and clear the sums
+        static void Report();
+
+        //Event-wise methods
+        //
+        //Start point of the shower (only the first one of the event is kept)
+        void SetStart( const G4ThreeVector& position, const G4ThreeVector& direction, G4double energy );
+        G4bool HasStart() const { return fEnergy > 0.; }
+        //Weighted calo and scintillator energies at the pre-step point of a step
+        void AddDeposit( const G4ThreeVector& position, const G4VTouchable* touchable, G4double edep );
+        void AddScintillator( G4double edep ) { if ( HasStart() ) fEScintillator += edep; }
+        void EndOfEvent();
+
+    private:
+        //Private constructor
+        ATLTileCalTBEmShowerTuner();
+
+        //Sums of the linear fits in x = ln(E/GeV) of the mean depth,
+        //mean squared depth and median radius of the showers
+        //
+        struct Sums {
+            G4double n;
+            G4double x;
+            G4double xx;
+            G4double xMin;
+            G4double xMax;
+            std::array<G4double, 3> y;
+            std::array<G4double, 3> xy;
+            G4double eCal;
+            G4double ePeriods;
+            G4double eScintillator;
+
+            void Add( const Sums& other );
+        };
+        static Sums fRunSums;
+        static constexpr G4double fRadialBin = 1. * CLHEP::mm;
+
+        G4bool fActive;
+        std::unique_ptr<ATLTileCalTBPeriodLayouts> fPeriodLayouts;
+        Sums fSums;
+        //Current event
+        G4ThreeVector fPosition;
+        G4ThreeVector fDirection;
+        G4double fEnergy;
+        G4double fECal;
+        G4double fEPeriods;
+        G4double fEScintillator;
+        G4double fDepthSum;
+        G4double fDepth2Sum;
+        std::vector<G4double> fRadialProfile;
+
+    public:
+        ATLTileCalTBEmShowerTuner(ATLTileCalTBEmShowerTuner const&) = delete;
+        void operator=(ATLTileCalTBEmShowerTuner const&) = delete;
+
+};
+
+#endif //ATLTileCalTBEmShower_h
+
+//**************************************************
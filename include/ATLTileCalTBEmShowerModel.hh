@@ -0,0 +1,79 @@
+//**************************************************
+// \file ATLTileCalTBEmShowerModel.hh
+// \brief: definition of ATLTileCalTBEmShowerModel
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Fast simulation model replacing the shower of a primary e+- entering
+// a period of a Tile module by energy spots sampled from the profile
+// of ATLTileCalTBEmShower (electron calibration runs). The spots are
+// located in the geometry: in a tile row of a period their sampling
+// fraction goes through the Birk, photoelectron, U-shape and PMT chain
+// with ATLTileCalTBSensDet::AddFastDeposit(), their energy is added to
+// Ecal (inside CALO::CALO, air envelopes and gaps included) or ELeak.
+// In tuning mode the start points
+// of the showers are passed to ATLTileCalTBEmShowerTuner instead and
+// the showers are fully simulated. One instance per thread.
+
+#ifndef ATLTileCalTBEmShowerModel_h
+#define ATLTileCalTBEmShowerModel_h 1
+
+//Includers from project files
+//
+#include "ATLTileCalTBGeometry.hh"
+#include "ATLTileCalTBPeriodLayouts.hh"
+
+//Includers from Geant4
+//
+#include "G4VFastSimulationModel.hh"
+#include "G4Navigator.hh"
+#include "G4TouchableHistory.hh"
+
+//Includers from C++
+//
+#include <vector>
+
+//Forward declaration from project
+//
+class ATLTileCalTBSensDet;
+
+//Forward declaration from Geant4
+//
+class G4Region;
+class G4LogicalVolume;
+
+class ATLTileCalTBEmShowerModel : public G4VFastSimulationModel {
+
+    public:
+        ATLTileCalTBEmShowerModel( const G4String& name, G4Region* region, ATLTileCalTBSensDet* sensDet );
+        virtual ~ATLTileCalTBEmShowerModel();
+
+        //Methods from base class
+        //
+        virtual G4bool IsApplicable( const G4ParticleDefinition& particle );
+        virtual G4bool ModelTrigger( const G4FastTrack& fastTrack );
+        virtual void DoIt( const G4FastTrack& fastTrack, G4FastStep& fastStep );
+
+    private:
+        //Deposit a spot at a global position
+        void AddSpot( const G4ThreeVector& position, G4double time, G4double energy );
+
+        ATLTileCalTBSensDet* fSensDet;
+        ATLTileCalTBPeriodLayouts fPeriodLayouts;
+        std::vector<ATLTileCalTBGeometry::VolumeRole> fVolumeRoles; //index is the logical volume ID
+        const G4LogicalVolume* fCaloVolume;
+        G4double fScintillatorDensity;
+
+        //Navigator (not the one of the tracking) to locate the spots
+        //
+        G4Navigator fNavigator;
+        G4TouchableHistory fTouchable;
+
+};
+
+#endif //ATLTileCalTBEmShowerModel_h
+
+//**************************************************
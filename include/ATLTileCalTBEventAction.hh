@@ -18,20 +18,24 @@
 //Includers from project files
 //
 #include "ATLTileCalTBHit.hh"
+#include "ATLTileCalTBRandomBuffer.hh"
+#include "ATLTileCalTBDigitizer.hh"
+#include "ATLTileCalTBDigiPipeline.hh"
+#include "ATLTileCalTBNtuple.hh"
 
 //Includers from C++
 //
 #include <array>
 #include <vector>
-#ifdef ATLTileCalTB_PulseOutput
 #include <filesystem>
-#endif
+#include <memory>
 
 //Forward declaration from project
 //
 class ATLTileCalTBPrimaryGenAction;
+class SpectrumAnalyzer;
 
-constexpr std::size_t nAuxData = 2; //0->Leakage, 1->Energy Deposited in Calo
+constexpr std::size_t nAuxData = 3; //0->Leakage, 1->Energy Deposited in Calo, 2->Kinetic energy of late tracks
 
 class ATLTileCalTBEventAction : public G4UserEventAction {
     
@@ -44,19 +48,58 @@ class ATLTileCalTBEventAction : public G4UserEventAction {
 
         void Add( std::size_t index, G4double de );
 
-        std::vector<G4double>& GetEdepVector() { return fEdepVector; };
-        std::vector<G4double>& GetSdepVector() { return fSdepVector; };
+        //Digitization and output modes, set at the beginning of each run
+        void SetRunModes( G4bool noise, G4bool pulseOutput, G4bool leakAnalysis );
+        //Spectrum analyzer of this thread if the leakage analysis is enabled, nullptr otherwise
+        SpectrumAnalyzer* GetSpectrumAnalyzer() const { return fSpectrumAnalyzer; }
+        //Time binning of the signal, set at the beginning of each run
+        void SetLayout( G4double binTime, G4double timeWindow );
+        //Tracks are killed after this global time (see ATLTileCalTBStackingAction), set at the beginning of each run
+        void SetTimeCut( G4double timeCut ) { fTimeCut = timeCut; }
+        G4double GetTimeCut() const { return fTimeCut; }
+        //Event ntuple of this thread (booked by ATLTileCalTBRunAction)
+        ATLTileCalTBNtuple& GetNtuple() { return fNtuple; }
+
+        //Accumulate the binned signal of all cells vs time over the run,
+        //fill it in the given histogram and print the late signal fractions
+        void SetSignalTimeProfile( G4bool enable );
+        void ReportSignalTimeProfile( G4int h1ID ) const;
+
+        //Digitize the events of this run on noOfThreads threads (0: at the end of each event),
+        //with the noise seeded from runSeed and the event ID. FinishPipeline() fills the
+        //ntuple rows of the events still in the pipeline
+        void StartPipeline( std::size_t noOfThreads, G4long runSeed );
+        void FinishPipeline();
 
     private:
         ATLTileCalTBHitsCollection* GetHitsCollection(G4int hcID, const G4Event* event) const;
+
+        //Cell signal from the hit, one instance per mode combination
+        //(selected once per run, no mode branches per cell)
+        template<G4bool Noise, G4bool PulseOutput>
+        G4double DigitizeCell( const ATLTileCalTBHit* hit );
+        void WritePulse( std::size_t cellIndex, const ATLTileCalTBDigitization::Pulse& sdepUp,
+                         const ATLTileCalTBDigitization::Pulse& sdepDown ) const;
+        //Fill a ntuple row from a digitized event of the pipeline
+        void FillNtuple( const ATLTileCalTBDigiPipeline::Event& event );
+
         ATLTileCalTBPrimaryGenAction* fPrimaryGenAction;
+        ATLTileCalTBRandomBuffer* fRandomBuffer;
+        ATLTileCalTBDigitizer fDigitizer;
         std::size_t fNoOfCells;
         std::array<G4double, nAuxData> fAux;
-        std::vector<G4double> fEdepVector;
-        std::vector<G4double> fSdepVector;
-        #ifdef ATLTileCalTB_PulseOutput
+        ATLTileCalTBNtuple fNtuple;
+        G4double (ATLTileCalTBEventAction::*fDigitizeCell)( const ATLTileCalTBHit* hit );
+        G4double fBinTime;
+        G4double fTimeWindow;
+        G4double fTimeCut;
+        std::size_t fFrames;
+        std::vector<G4double> fSignalTimeProfile;
+        G4bool fNoise;
+        G4bool fPulseOutput;
+        SpectrumAnalyzer* fSpectrumAnalyzer;
+        std::unique_ptr<ATLTileCalTBDigiPipeline> fPipeline;
         std::filesystem::path pulse_event_path;
-        #endif
 };
                      
 inline void ATLTileCalTBEventAction::Add( std::size_t index, G4double de ) { fAux[index] += de; }
@@ -10,14 +10,14 @@
 #ifndef ATLTileCalTBGeometry_h
 #define ATLTileCalTBGeometry_h 1
 
-//Includers from Geant4
-//
-#include "G4ThreadLocalSingleton.hh"
-
 //Includers from C++
 //
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <ostream>
+#include <string_view>
+#include <utility>
 
 
 namespace ATLTileCalTBGeometry {
@@ -59,149 +59,493 @@ namespace ATLTileCalTBGeometry {
     };
     std::ostream& operator<<(std::ostream& ostream, const Cell& cell);
 
-    class CellLUT {
-        friend class G4ThreadLocalSingleton<CellLUT>;
+    // Role of a logical volume of the test-beam geometry
+    enum class VolumeRole : std::uint8_t {
+        WORLD,         // world volume
+        ENVELOPE,      // air mother volumes of the calorimeter and unknown volumes
+        ABSORBER,      // iron of the periods
+        SCINTILLATOR,  // tiles
+        PASSIVE,       // girders, fingers, end and front plates, glue
+        ANCILLARY,     // beam line and muon wall
+    };
+
+    // Logical volume names (as read from the GDML file) and roles
+    inline constexpr std::array<std::pair<std::string_view, VolumeRole>, 42> volume_roles {{
+        {"CTB::CTB",                      VolumeRole::WORLD},
+        {"CALO::CALO",                    VolumeRole::ENVELOPE},
+        {"Tile::TileTBEnv",               VolumeRole::ENVELOPE},
+        {"Tile::Barrel",                  VolumeRole::ENVELOPE},
+        {"Tile::BarrelModule",            VolumeRole::ENVELOPE},
+        {"Tile::EBarrel",                 VolumeRole::ENVELOPE},
+        {"Tile::EBarrelModule",           VolumeRole::ENVELOPE},
+        {"Tile::ITC",                     VolumeRole::ENVELOPE},
+        {"Tile::ITCModule",               VolumeRole::ENVELOPE},
+        {"Tile::Plug1Module",             VolumeRole::ENVELOPE},
+        {"Tile::Plug2Module",             VolumeRole::ENVELOPE},
+        {"Tile::Finger",                  VolumeRole::ENVELOPE},
+        {"Tile::FingerModule",            VolumeRole::ENVELOPE},
+        {"Tile::EFinger",                 VolumeRole::ENVELOPE},
+        {"Tile::EFingerModule",           VolumeRole::ENVELOPE},
+        {"Tile::GirderMother",            VolumeRole::ENVELOPE},
+        {"Tile::AbsorberChild",           VolumeRole::ENVELOPE},
+        {"Tile::Wrapper",                 VolumeRole::ENVELOPE},
+        {"Tile::EPHole1",                 VolumeRole::ENVELOPE},
+        {"Tile::EPHole2",                 VolumeRole::ENVELOPE},
+        {"Tile::Absorber",                VolumeRole::ABSORBER},
+        {"Tile::Period",                  VolumeRole::ABSORBER},
+        {"Tile::Scintillator",            VolumeRole::SCINTILLATOR},
+        {"Tile::Glue",                    VolumeRole::PASSIVE},
+        {"Tile::FrontPlate",              VolumeRole::PASSIVE},
+        {"Tile::FrontPlateSh",            VolumeRole::PASSIVE},
+        {"Tile::EndPlate1",               VolumeRole::PASSIVE},
+        {"Tile::EndPlate2",               VolumeRole::PASSIVE},
+        {"Tile::EndPlateSh",              VolumeRole::PASSIVE},
+        {"Tile::GirderIron",              VolumeRole::PASSIVE},
+        {"Tile::GirderAluminium",         VolumeRole::PASSIVE},
+        {"Tile::GirderElectronics",       VolumeRole::PASSIVE},
+        {"Tile::FingerIron",              VolumeRole::PASSIVE},
+        {"Tile::FingerAluminum",          VolumeRole::PASSIVE},
+        {"Tile::FingerElectronics",       VolumeRole::PASSIVE},
+        {"MuonWall::MuonWall",            VolumeRole::ANCILLARY},
+        {"MuonWall::MuScintillatorLayer", VolumeRole::ANCILLARY},
+        {"BEAMPIPE1::BEAMPIPE1",          VolumeRole::ANCILLARY},
+        {"BEAMPIPE2::BEAMPIPE2",          VolumeRole::ANCILLARY},
+        {"S1::S1",                        VolumeRole::ANCILLARY},
+        {"S2::S2",                        VolumeRole::ANCILLARY},
+        {"S3::S3",                        VolumeRole::ANCILLARY},
+    }};
+
+    // Returns the role of a logical volume from its name
+    constexpr VolumeRole GetVolumeRole(std::string_view name) {
+        for (const auto& entry : volume_roles) {
+            if (entry.first == name) return entry.second;
+        }
+        return VolumeRole::ENVELOPE;
+    }
+
+    // Returns true if the energy deposited in a volume is part of the calorimeter energy
+    constexpr bool IsCalorimeter(VolumeRole role) {
+        return role == VolumeRole::ABSORBER || role == VolumeRole::SCINTILLATOR || role == VolumeRole::PASSIVE;
+    }
+    static_assert(GetVolumeRole("Tile::Scintillator") == VolumeRole::SCINTILLATOR &&
+                  GetVolumeRole("Barrel") == VolumeRole::ENVELOPE, "wrong volume roles");
+
+    // Regions of the calorimeter volumes (production cuts and user limits per region),
+    // the volumes of the other roles are in the default region of the world
+    inline constexpr std::array<std::pair<VolumeRole, std::string_view>, 3> region_names {{
+        {VolumeRole::ABSORBER,     "Absorber"},
+        {VolumeRole::SCINTILLATOR, "Scintillator"},
+        {VolumeRole::PASSIVE,      "Passive"},
+    }};
+
+    // Region of the whole calorimeter (root volume CALO::CALO) replacing the absorber and passive
+    // regions with Woodcock tracking of the photons (photons cross it in a few steps), the
+    // scintillator region is kept out of it
+    inline constexpr std::string_view calo_region_name = "CALO";
+    inline constexpr std::string_view calo_region_volume = "CALO::CALO";
+
+    // Returns the name of the region of a volume role (empty if in the default region)
+    constexpr std::string_view GetRegionName(VolumeRole role) {
+        for (const auto& entry : region_names) {
+            if (entry.first == role) return entry.second;
+        }
+        return {};
+    }
+
+    // Stateless cell lookup table, everything is resolved at compile time
+    namespace CellLUT {
+
+        // Total numbers of cells
+        constexpr std::size_t no_of_cells = 104;
+
+        // Number of tile rows in a module (scintillator copy numbers)
+        constexpr std::size_t no_of_rows = 11;
+
+        // Returned by FindCellIndex if no cell matches
+        constexpr std::size_t invalid_cell_index = SIZE_MAX;
+
+        // Cell vector
+        // https://atlas-geometry-db.web.cern.ch/atlas-geometry-db/node_tag_browser.php
+        // TileCal -> TICL -> TICL-00
+        inline constexpr std::array<const Cell, no_of_cells> cell_vector {
+            // Lower long module
+            Cell(Module::LONG_LOWER,   Row::A, -10,  1,  3, 16, 16, 16,  0,  0,  0), //   0
+            Cell(Module::LONG_LOWER,   Row::A,  -9,  1,  3, 18, 19, 18,  0,  0,  0), //   1
+            Cell(Module::LONG_LOWER,   Row::A,  -8,  1,  3, 18, 17, 18,  0,  0,  0), //   2
+            Cell(Module::LONG_LOWER,   Row::A,  -7,  1,  3, 16, 16, 16,  0,  0,  0), //   3
+            Cell(Module::LONG_LOWER,   Row::A,  -6,  1,  3, 15, 16, 15,  0,  0,  0), //   4
+            Cell(Module::LONG_LOWER,   Row::A,  -5,  1,  3, 15, 15, 15,  0,  0,  0), //   5
+            Cell(Module::LONG_LOWER,   Row::A,  -4,  1,  3, 14, 14, 14,  0,  0,  0), //   6
+            Cell(Module::LONG_LOWER,   Row::A,  -3,  1,  3, 14, 14, 14,  0,  0,  0), //   7
+            Cell(Module::LONG_LOWER,   Row::A,  -2,  1,  3, 14, 13, 14,  0,  0,  0), //   8
+            Cell(Module::LONG_LOWER,   Row::A,  -1,  1,  3, 13, 14, 13,  0,  0,  0), //   9
+            Cell(Module::LONG_LOWER,   Row::A,   1,  1,  3, 14, 13, 14,  0,  0,  0), //  10
+            Cell(Module::LONG_LOWER,   Row::A,   2,  1,  3, 13, 14, 13,  0,  0,  0), //  11
+            Cell(Module::LONG_LOWER,   Row::A,   3,  1,  3, 14, 14, 14,  0,  0,  0), //  12
+            Cell(Module::LONG_LOWER,   Row::A,   4,  1,  3, 14, 14, 14,  0,  0,  0), //  13
+            Cell(Module::LONG_LOWER,   Row::A,   5,  1,  3, 15, 15, 15,  0,  0,  0), //  14
+            Cell(Module::LONG_LOWER,   Row::A,   6,  1,  3, 16, 15, 16,  0,  0,  0), //  15
+            Cell(Module::LONG_LOWER,   Row::A,   7,  1,  3, 16, 16, 16,  0,  0,  0), //  16
+            Cell(Module::LONG_LOWER,   Row::A,   8,  1,  3, 17, 18, 17,  0,  0,  0), //  17
+            Cell(Module::LONG_LOWER,   Row::A,   9,  1,  3, 19, 18, 19,  0,  0,  0), //  18
+            Cell(Module::LONG_LOWER,   Row::A,  10,  1,  3, 16, 16, 16,  0,  0,  0), //  19
+            Cell(Module::LONG_LOWER,   Row::BC, -9,  4,  9, 18, 17, 18,  0,  0,  0), //  20
+            Cell(Module::LONG_LOWER,   Row::BC, -8,  4,  9, 20, 20, 20, 20, 20, 20), //  21
+            Cell(Module::LONG_LOWER,   Row::BC, -7,  4,  9, 18, 19, 18, 21, 22, 21), //  22
+            Cell(Module::LONG_LOWER,   Row::BC, -6,  4,  9, 18, 18, 18, 21, 20, 21), //  23
+            Cell(Module::LONG_LOWER,   Row::BC, -5,  4,  9, 17, 16, 17, 19, 19, 19), //  24
+            Cell(Module::LONG_LOWER,   Row::BC, -4,  4,  9, 16, 17, 16, 19, 19, 19), //  25
+            Cell(Module::LONG_LOWER,   Row::BC, -3,  4,  9, 16, 15, 16, 18, 18, 18), //  26
+            Cell(Module::LONG_LOWER,   Row::BC, -2,  4,  9, 15, 16, 15, 18, 18, 18), //  27
+            Cell(Module::LONG_LOWER,   Row::BC, -1,  4,  9, 16, 15, 16, 17, 18, 17), //  28
+            Cell(Module::LONG_LOWER,   Row::BC,  1,  4,  9, 15, 16, 15, 18, 17, 18), //  29
+            Cell(Module::LONG_LOWER,   Row::BC,  2,  4,  9, 16, 15, 16, 18, 18, 18), //  30
+            Cell(Module::LONG_LOWER,   Row::BC,  3,  4,  9, 15, 16, 15, 18, 18, 18), //  31
+            Cell(Module::LONG_LOWER,   Row::BC,  4,  4,  9, 17, 16, 17, 19, 19, 19), //  32
+            Cell(Module::LONG_LOWER,   Row::BC,  5,  4,  9, 16, 17, 16, 19, 19, 19), //  33
+            Cell(Module::LONG_LOWER,   Row::BC,  6,  4,  9, 18, 18, 18, 20, 21, 20), //  34
+            Cell(Module::LONG_LOWER,   Row::BC,  7,  4,  9, 19, 18, 19, 22, 21, 22), //  35
+            Cell(Module::LONG_LOWER,   Row::BC,  8,  4,  9, 20, 20, 20, 20, 20, 20), //  36
+            Cell(Module::LONG_LOWER,   Row::BC,  9,  4,  9, 17, 18, 17,  0,  0,  0), //  37
+            Cell(Module::LONG_LOWER,   Row::D,  -3, 10, 11, 50, 50,  0,  0,  0,  0), //  38
+            Cell(Module::LONG_LOWER,   Row::D,  -2, 10, 11, 43, 43,  0,  0,  0,  0), //  39
+            Cell(Module::LONG_LOWER,   Row::D,  -1, 10, 11, 41, 40,  0,  0,  0,  0), //  40
+            Cell(Module::LONG_LOWER,   Row::D,   0, 10, 11, 40, 40,  0,  0,  0,  0), //  41
+            Cell(Module::LONG_LOWER,   Row::D,   1, 10, 11, 40, 41,  0,  0,  0,  0), //  42
+            Cell(Module::LONG_LOWER,   Row::D,   2, 10, 11, 43, 43,  0,  0,  0,  0), //  43
+            Cell(Module::LONG_LOWER,   Row::D,   3, 10, 11, 50, 50,  0,  0,  0,  0), //  44
+            // Upper long module
+            Cell(Module::LONG_UPPER,   Row::A, -10,  1,  3, 16, 16, 16,  0,  0,  0), //  45
+            Cell(Module::LONG_UPPER,   Row::A,  -9,  1,  3, 18, 19, 18,  0,  0,  0), //  46
+            Cell(Module::LONG_UPPER,   Row::A,  -8,  1,  3, 18, 17, 18,  0,  0,  0), //  47
+            Cell(Module::LONG_UPPER,   Row::A,  -7,  1,  3, 16, 16, 16,  0,  0,  0), //  48
+            Cell(Module::LONG_UPPER,   Row::A,  -6,  1,  3, 15, 16, 15,  0,  0,  0), //  49
+            Cell(Module::LONG_UPPER,   Row::A,  -5,  1,  3, 15, 15, 15,  0,  0,  0), //  50
+            Cell(Module::LONG_UPPER,   Row::A,  -4,  1,  3, 14, 14, 14,  0,  0,  0), //  51
+            Cell(Module::LONG_UPPER,   Row::A,  -3,  1,  3, 14, 14, 14,  0,  0,  0), //  52
+            Cell(Module::LONG_UPPER,   Row::A,  -2,  1,  3, 14, 13, 14,  0,  0,  0), //  53
+            Cell(Module::LONG_UPPER,   Row::A,  -1,  1,  3, 13, 14, 13,  0,  0,  0), //  54
+            Cell(Module::LONG_UPPER,   Row::A,   1,  1,  3, 14, 13, 14,  0,  0,  0), //  55
+            Cell(Module::LONG_UPPER,   Row::A,   2,  1,  3, 13, 14, 13,  0,  0,  0), //  56
+            Cell(Module::LONG_UPPER,   Row::A,   3,  1,  3, 14, 14, 14,  0,  0,  0), //  57
+            Cell(Module::LONG_UPPER,   Row::A,   4,  1,  3, 14, 14, 14,  0,  0,  0), //  58
+            Cell(Module::LONG_UPPER,   Row::A,   5,  1,  3, 15, 15, 15,  0,  0,  0), //  59
+            Cell(Module::LONG_UPPER,   Row::A,   6,  1,  3, 16, 15, 16,  0,  0,  0), //  60
+            Cell(Module::LONG_UPPER,   Row::A,   7,  1,  3, 16, 16, 16,  0,  0,  0), //  61
+            Cell(Module::LONG_UPPER,   Row::A,   8,  1,  3, 17, 18, 17,  0,  0,  0), //  62
+            Cell(Module::LONG_UPPER,   Row::A,   9,  1,  3, 19, 18, 19,  0,  0,  0), //  63
+            Cell(Module::LONG_UPPER,   Row::A,  10,  1,  3, 16, 16, 16,  0,  0,  0), //  64
+            Cell(Module::LONG_UPPER,   Row::BC, -9,  4,  9, 18, 17, 18,  0,  0,  0), //  65
+            Cell(Module::LONG_UPPER,   Row::BC, -8,  4,  9, 20, 20, 20, 20, 20, 20), //  66
+            Cell(Module::LONG_UPPER,   Row::BC, -7,  4,  9, 18, 19, 18, 21, 22, 21), //  67
+            Cell(Module::LONG_UPPER,   Row::BC, -6,  4,  9, 18, 18, 18, 21, 20, 21), //  68
+            Cell(Module::LONG_UPPER,   Row::BC, -5,  4,  9, 17, 16, 17, 19, 19, 19), //  69
+            Cell(Module::LONG_UPPER,   Row::BC, -4,  4,  9, 16, 17, 16, 19, 19, 19), //  70
+            Cell(Module::LONG_UPPER,   Row::BC, -3,  4,  9, 16, 15, 16, 18, 18, 18), //  71
+            Cell(Module::LONG_UPPER,   Row::BC, -2,  4,  9, 15, 16, 15, 18, 18, 18), //  72
+            Cell(Module::LONG_UPPER,   Row::BC, -1,  4,  9, 16, 15, 16, 17, 18, 17), //  73
+            Cell(Module::LONG_UPPER,   Row::BC,  1,  4,  9, 15, 16, 15, 18, 17, 18), //  74
+            Cell(Module::LONG_UPPER,   Row::BC,  2,  4,  9, 16, 15, 16, 18, 18, 18), //  75
+            Cell(Module::LONG_UPPER,   Row::BC,  3,  4,  9, 15, 16, 15, 18, 18, 18), //  76
+            Cell(Module::LONG_UPPER,   Row::BC,  4,  4,  9, 17, 16, 17, 19, 19, 19), //  77
+            Cell(Module::LONG_UPPER,   Row::BC,  5,  4,  9, 16, 17, 16, 19, 19, 19), //  78
+            Cell(Module::LONG_UPPER,   Row::BC,  6,  4,  9, 18, 18, 18, 20, 21, 20), //  79
+            Cell(Module::LONG_UPPER,   Row::BC,  7,  4,  9, 19, 18, 19, 22, 21, 22), //  80
+            Cell(Module::LONG_UPPER,   Row::BC,  8,  4,  9, 20, 20, 20, 20, 20, 20), //  81
+            Cell(Module::LONG_UPPER,   Row::BC,  9,  4,  9, 17, 18, 17,  0,  0,  0), //  82
+            Cell(Module::LONG_UPPER,   Row::D,  -3, 10, 11, 50, 50,  0,  0,  0,  0), //  83
+            Cell(Module::LONG_UPPER,   Row::D,  -2, 10, 11, 43, 43,  0,  0,  0,  0), //  84
+            Cell(Module::LONG_UPPER,   Row::D,  -1, 10, 11, 41, 40,  0,  0,  0,  0), //  85
+            Cell(Module::LONG_UPPER,   Row::D,   0, 10, 11, 40, 40,  0,  0,  0,  0), //  86
+            Cell(Module::LONG_UPPER,   Row::D,   1, 10, 11, 40, 41,  0,  0,  0,  0), //  87
+            Cell(Module::LONG_UPPER,   Row::D,   2, 10, 11, 43, 43,  0,  0,  0,  0), //  88
+            Cell(Module::LONG_UPPER,   Row::D,   3, 10, 11, 50, 50,  0,  0,  0,  0), //  89
+            // Extended module
+            Cell(Module::EXTENDED,     Row::A,  12,  1,  3,  9,  9,  9,  0,  0,  0), //  90
+            Cell(Module::EXTENDED,     Row::A,  13,  1,  3, 25, 25, 25,  0,  0,  0), //  91
+            Cell(Module::EXTENDED,     Row::A,  14,  1,  3, 28, 28, 28,  0,  0,  0), //  92
+            Cell(Module::EXTENDED,     Row::A,  15,  1,  3, 30, 30, 30,  0,  0,  0), //  93
+            Cell(Module::EXTENDED,     Row::A,  16,  1,  3, 48, 48, 48,  0,  0,  0), //  94
+            Cell(Module::EXTENDED,     Row::B,  11,  4,  7, 16, 16, 16, 16,  0,  0), //  95
+            Cell(Module::EXTENDED,     Row::B,  12,  4,  7, 27, 27, 27, 27,  0,  0), //  96
+            Cell(Module::EXTENDED,     Row::B,  13,  4,  7, 30, 30, 30, 30,  0,  0), //  97
+            Cell(Module::EXTENDED,     Row::B,  14,  4,  7, 32, 32, 32, 32,  0,  0), //  98
+            Cell(Module::EXTENDED,     Row::B,  15,  4,  7, 35, 35, 35, 35,  0,  0), //  99
+            Cell(Module::EXTENDED,     Row::D,   5,  8, 11, 65, 65, 65, 65,  0,  0), // 100
+            Cell(Module::EXTENDED,     Row::D,   6,  8, 11, 75, 75, 75, 75,  0,  0), // 101
+            Cell(Module::EXTENDED_C10, Row::C,  10,  1,  3,  6,  5,  6,  0,  0,  0), // 102
+            Cell(Module::EXTENDED_D4,  Row::D,   4,  4,  5, 17, 17,  0,  0,  0,  0), // 103
+        };
+
+        // Returns the total number of cells
+        constexpr std::size_t GetNumberOfCells() { return no_of_cells; }
+
+        // Returns a constant reference of the cell corresponding to the cell index
+        constexpr const Cell& GetCell(std::size_t index) { return cell_vector[index]; }
 
-        public:
-            // Returns pointer to Singleton
-            static CellLUT* GetInstance() {
-                static G4ThreadLocalSingleton<CellLUT> instance {};
-                return instance.Instance();
+        // Returns the number of cells in a module
+        constexpr std::size_t GetNumberOfCells(Module module) {
+            std::size_t n = 0;
+            for (const auto& cell : cell_vector) {
+                if (cell.module == module) ++n;
             }
+            return n;
+        }
 
-            // Returns the total number of cells
-            inline constexpr std::size_t GetNumberOfCells() const { return fNoOfCells; };
-
-            // Finds the cell index given a module, the row index and the cell index
-            std::size_t FindCellIndex(Module module, std::size_t rowIdx, std::size_t tileIdx) const;
-
-            // Returns a constant reference of the cell corresponding to the cell index 
-            inline constexpr Cell GetCell(std::size_t index) const { return fCellVector[index]; };
-
-        private:
-            // Private constructor
-            CellLUT() = default;
-
-            // Total numbers of cells
-            static constexpr std::size_t fNoOfCells = 104;
-
-            // Cell vector
-            // https://atlas-geometry-db.web.cern.ch/atlas-geometry-db/node_tag_browser.php
-            // TileCal -> TICL -> TICL-00
-            static constexpr std::array<const Cell, fNoOfCells> fCellVector {
-                // Lower long module
-                Cell(Module::LONG_LOWER,   Row::A, -10,  1,  3, 16, 16, 16,  0,  0,  0), //   0
-                Cell(Module::LONG_LOWER,   Row::A,  -9,  1,  3, 18, 19, 18,  0,  0,  0), //   1
-                Cell(Module::LONG_LOWER,   Row::A,  -8,  1,  3, 18, 17, 18,  0,  0,  0), //   2
-                Cell(Module::LONG_LOWER,   Row::A,  -7,  1,  3, 16, 16, 16,  0,  0,  0), //   3
-                Cell(Module::LONG_LOWER,   Row::A,  -6,  1,  3, 15, 16, 15,  0,  0,  0), //   4
-                Cell(Module::LONG_LOWER,   Row::A,  -5,  1,  3, 15, 15, 15,  0,  0,  0), //   5
-                Cell(Module::LONG_LOWER,   Row::A,  -4,  1,  3, 14, 14, 14,  0,  0,  0), //   6
-                Cell(Module::LONG_LOWER,   Row::A,  -3,  1,  3, 14, 14, 14,  0,  0,  0), //   7
-                Cell(Module::LONG_LOWER,   Row::A,  -2,  1,  3, 14, 13, 14,  0,  0,  0), //   8
-                Cell(Module::LONG_LOWER,   Row::A,  -1,  1,  3, 13, 14, 13,  0,  0,  0), //   9
-                Cell(Module::LONG_LOWER,   Row::A,   1,  1,  3, 14, 13, 14,  0,  0,  0), //  10
-                Cell(Module::LONG_LOWER,   Row::A,   2,  1,  3, 13, 14, 13,  0,  0,  0), //  11
-                Cell(Module::LONG_LOWER,   Row::A,   3,  1,  3, 14, 14, 14,  0,  0,  0), //  12
-                Cell(Module::LONG_LOWER,   Row::A,   4,  1,  3, 14, 14, 14,  0,  0,  0), //  13
-                Cell(Module::LONG_LOWER,   Row::A,   5,  1,  3, 15, 15, 15,  0,  0,  0), //  14
-                Cell(Module::LONG_LOWER,   Row::A,   6,  1,  3, 16, 15, 16,  0,  0,  0), //  15
-                Cell(Module::LONG_LOWER,   Row::A,   7,  1,  3, 16, 16, 16,  0,  0,  0), //  16
-                Cell(Module::LONG_LOWER,   Row::A,   8,  1,  3, 17, 18, 17,  0,  0,  0), //  17
-                Cell(Module::LONG_LOWER,   Row::A,   9,  1,  3, 19, 18, 19,  0,  0,  0), //  18
-                Cell(Module::LONG_LOWER,   Row::A,  10,  1,  3, 16, 16, 16,  0,  0,  0), //  19
-                Cell(Module::LONG_LOWER,   Row::BC, -9,  4,  9, 18, 17, 18,  0,  0,  0), //  20
-                Cell(Module::LONG_LOWER,   Row::BC, -8,  4,  9, 20, 20, 20, 20, 20, 20), //  21
-                Cell(Module::LONG_LOWER,   Row::BC, -7,  4,  9, 18, 19, 18, 21, 22, 21), //  22
-                Cell(Module::LONG_LOWER,   Row::BC, -6,  4,  9, 18, 18, 18, 21, 20, 21), //  23
-                Cell(Module::LONG_LOWER,   Row::BC, -5,  4,  9, 17, 16, 17, 19, 19, 19), //  24
-                Cell(Module::LONG_LOWER,   Row::BC, -4,  4,  9, 16, 17, 16, 19, 19, 19), //  25
-                Cell(Module::LONG_LOWER,   Row::BC, -3,  4,  9, 16, 15, 16, 18, 18, 18), //  26
-                Cell(Module::LONG_LOWER,   Row::BC, -2,  4,  9, 15, 16, 15, 18, 18, 18), //  27
-                Cell(Module::LONG_LOWER,   Row::BC, -1,  4,  9, 16, 15, 16, 17, 18, 17), //  28
-                Cell(Module::LONG_LOWER,   Row::BC,  1,  4,  9, 15, 16, 15, 18, 17, 18), //  29
-                Cell(Module::LONG_LOWER,   Row::BC,  2,  4,  9, 16, 15, 16, 18, 18, 18), //  30
-                Cell(Module::LONG_LOWER,   Row::BC,  3,  4,  9, 15, 16, 15, 18, 18, 18), //  31
-                Cell(Module::LONG_LOWER,   Row::BC,  4,  4,  9, 17, 16, 17, 19, 19, 19), //  32
-                Cell(Module::LONG_LOWER,   Row::BC,  5,  4,  9, 16, 17, 16, 19, 19, 19), //  33
-                Cell(Module::LONG_LOWER,   Row::BC,  6,  4,  9, 18, 18, 18, 20, 21, 20), //  34
-                Cell(Module::LONG_LOWER,   Row::BC,  7,  4,  9, 19, 18, 19, 22, 21, 22), //  35
-                Cell(Module::LONG_LOWER,   Row::BC,  8,  4,  9, 20, 20, 20, 20, 20, 20), //  36
-                Cell(Module::LONG_LOWER,   Row::BC,  9,  4,  9, 17, 18, 17,  0,  0,  0), //  37
-                Cell(Module::LONG_LOWER,   Row::D,  -3, 10, 11, 50, 50,  0,  0,  0,  0), //  38
-                Cell(Module::LONG_LOWER,   Row::D,  -2, 10, 11, 43, 43,  0,  0,  0,  0), //  39
-                Cell(Module::LONG_LOWER,   Row::D,  -1, 10, 11, 41, 40,  0,  0,  0,  0), //  40
-                Cell(Module::LONG_LOWER,   Row::D,   0, 10, 11, 40, 40,  0,  0,  0,  0), //  41
-                Cell(Module::LONG_LOWER,   Row::D,   1, 10, 11, 40, 41,  0,  0,  0,  0), //  42
-                Cell(Module::LONG_LOWER,   Row::D,   2, 10, 11, 43, 43,  0,  0,  0,  0), //  43
-                Cell(Module::LONG_LOWER,   Row::D,   3, 10, 11, 50, 50,  0,  0,  0,  0), //  44
-                // Upper long module
-                Cell(Module::LONG_UPPER,   Row::A, -10,  1,  3, 16, 16, 16,  0,  0,  0), //  45
-                Cell(Module::LONG_UPPER,   Row::A,  -9,  1,  3, 18, 19, 18,  0,  0,  0), //  46
-                Cell(Module::LONG_UPPER,   Row::A,  -8,  1,  3, 18, 17, 18,  0,  0,  0), //  47
-                Cell(Module::LONG_UPPER,   Row::A,  -7,  1,  3, 16, 16, 16,  0,  0,  0), //  48
-                Cell(Module::LONG_UPPER,   Row::A,  -6,  1,  3, 15, 16, 15,  0,  0,  0), //  49
-                Cell(Module::LONG_UPPER,   Row::A,  -5,  1,  3, 15, 15, 15,  0,  0,  0), //  50
-                Cell(Module::LONG_UPPER,   Row::A,  -4,  1,  3, 14, 14, 14,  0,  0,  0), //  51
-                Cell(Module::LONG_UPPER,   Row::A,  -3,  1,  3, 14, 14, 14,  0,  0,  0), //  52
-                Cell(Module::LONG_UPPER,   Row::A,  -2,  1,  3, 14, 13, 14,  0,  0,  0), //  53
-                Cell(Module::LONG_UPPER,   Row::A,  -1,  1,  3, 13, 14, 13,  0,  0,  0), //  54
-                Cell(Module::LONG_UPPER,   Row::A,   1,  1,  3, 14, 13, 14,  0,  0,  0), //  55
-                Cell(Module::LONG_UPPER,   Row::A,   2,  1,  3, 13, 14, 13,  0,  0,  0), //  56
-                Cell(Module::LONG_UPPER,   Row::A,   3,  1,  3, 14, 14, 14,  0,  0,  0), //  57
-                Cell(Module::LONG_UPPER,   Row::A,   4,  1,  3, 14, 14, 14,  0,  0,  0), //  58
-                Cell(Module::LONG_UPPER,   Row::A,   5,  1,  3, 15, 15, 15,  0,  0,  0), //  59
-                Cell(Module::LONG_UPPER,   Row::A,   6,  1,  3, 16, 15, 16,  0,  0,  0), //  60
-                Cell(Module::LONG_UPPER,   Row::A,   7,  1,  3, 16, 16, 16,  0,  0,  0), //  61
-                Cell(Module::LONG_UPPER,   Row::A,   8,  1,  3, 17, 18, 17,  0,  0,  0), //  62
-                Cell(Module::LONG_UPPER,   Row::A,   9,  1,  3, 19, 18, 19,  0,  0,  0), //  63
-                Cell(Module::LONG_UPPER,   Row::A,  10,  1,  3, 16, 16, 16,  0,  0,  0), //  64
-                Cell(Module::LONG_UPPER,   Row::BC, -9,  4,  9, 18, 17, 18,  0,  0,  0), //  65
-                Cell(Module::LONG_UPPER,   Row::BC, -8,  4,  9, 20, 20, 20, 20, 20, 20), //  66
-                Cell(Module::LONG_UPPER,   Row::BC, -7,  4,  9, 18, 19, 18, 21, 22, 21), //  67
-                Cell(Module::LONG_UPPER,   Row::BC, -6,  4,  9, 18, 18, 18, 21, 20, 21), //  68
-                Cell(Module::LONG_UPPER,   Row::BC, -5,  4,  9, 17, 16, 17, 19, 19, 19), //  69
-                Cell(Module::LONG_UPPER,   Row::BC, -4,  4,  9, 16, 17, 16, 19, 19, 19), //  70
-                Cell(Module::LONG_UPPER,   Row::BC, -3,  4,  9, 16, 15, 16, 18, 18, 18), //  71
-                Cell(Module::LONG_UPPER,   Row::BC, -2,  4,  9, 15, 16, 15, 18, 18, 18), //  72
-                Cell(Module::LONG_UPPER,   Row::BC, -1,  4,  9, 16, 15, 16, 17, 18, 17), //  73
-                Cell(Module::LONG_UPPER,   Row::BC,  1,  4,  9, 15, 16, 15, 18, 17, 18), //  74
-                Cell(Module::LONG_UPPER,   Row::BC,  2,  4,  9, 16, 15, 16, 18, 18, 18), //  75
-                Cell(Module::LONG_UPPER,   Row::BC,  3,  4,  9, 15, 16, 15, 18, 18, 18), //  76
-                Cell(Module::LONG_UPPER,   Row::BC,  4,  4,  9, 17, 16, 17, 19, 19, 19), //  77
-                Cell(Module::LONG_UPPER,   Row::BC,  5,  4,  9, 16, 17, 16, 19, 19, 19), //  78
-                Cell(Module::LONG_UPPER,   Row::BC,  6,  4,  9, 18, 18, 18, 20, 21, 20), //  79
-                Cell(Module::LONG_UPPER,   Row::BC,  7,  4,  9, 19, 18, 19, 22, 21, 22), //  80
-                Cell(Module::LONG_UPPER,   Row::BC,  8,  4,  9, 20, 20, 20, 20, 20, 20), //  81
-                Cell(Module::LONG_UPPER,   Row::BC,  9,  4,  9, 17, 18, 17,  0,  0,  0), //  82
-                Cell(Module::LONG_UPPER,   Row::D,  -3, 10, 11, 50, 50,  0,  0,  0,  0), //  83
-                Cell(Module::LONG_UPPER,   Row::D,  -2, 10, 11, 43, 43,  0,  0,  0,  0), //  84
-                Cell(Module::LONG_UPPER,   Row::D,  -1, 10, 11, 41, 40,  0,  0,  0,  0), //  85
-                Cell(Module::LONG_UPPER,   Row::D,   0, 10, 11, 40, 40,  0,  0,  0,  0), //  86
-                Cell(Module::LONG_UPPER,   Row::D,   1, 10, 11, 40, 41,  0,  0,  0,  0), //  87
-                Cell(Module::LONG_UPPER,   Row::D,   2, 10, 11, 43, 43,  0,  0,  0,  0), //  88
-                Cell(Module::LONG_UPPER,   Row::D,   3, 10, 11, 50, 50,  0,  0,  0,  0), //  89
-                // Extended module
-                Cell(Module::EXTENDED,     Row::A,  12,  1,  3,  9,  9,  9,  0,  0,  0), //  90
-                Cell(Module::EXTENDED,     Row::A,  13,  1,  3, 25, 25, 25,  0,  0,  0), //  91
-                Cell(Module::EXTENDED,     Row::A,  14,  1,  3, 28, 28, 28,  0,  0,  0), //  92
-                Cell(Module::EXTENDED,     Row::A,  15,  1,  3, 30, 30, 30,  0,  0,  0), //  93
-                Cell(Module::EXTENDED,     Row::A,  16,  1,  3, 48, 48, 48,  0,  0,  0), //  94
-                Cell(Module::EXTENDED,     Row::B,  11,  4,  7, 16, 16, 16, 16,  0,  0), //  95
-                Cell(Module::EXTENDED,     Row::B,  12,  4,  7, 27, 27, 27, 27,  0,  0), //  96
-                Cell(Module::EXTENDED,     Row::B,  13,  4,  7, 30, 30, 30, 30,  0,  0), //  97
-                Cell(Module::EXTENDED,     Row::B,  14,  4,  7, 32, 32, 32, 32,  0,  0), //  98
-                Cell(Module::EXTENDED,     Row::B,  15,  4,  7, 35, 35, 35, 35,  0,  0), //  99
-                Cell(Module::EXTENDED,     Row::D,   5,  8, 11, 65, 65, 65, 65,  0,  0), // 100
-                Cell(Module::EXTENDED,     Row::D,   6,  8, 11, 75, 75, 75, 75,  0,  0), // 101
-                Cell(Module::EXTENDED_C10, Row::C,  10,  1,  3,  6,  5,  6,  0,  0,  0), // 102
-                Cell(Module::EXTENDED_D4,  Row::D,   4,  4,  5, 17, 17,  0,  0,  0,  0), // 103
-            };
-
-        public:
-            CellLUT(CellLUT const&) = delete;
-            void operator=(CellLUT const&) = delete;
-    };
+        // Returns the index of the first cell in a module
+        constexpr std::size_t GetFirstCellIndex(Module module) {
+            for (std::size_t index = 0; index < no_of_cells; ++index) {
+                if (cell_vector[index].module == module) return index;
+            }
+            return invalid_cell_index;
+        }
+
+        // Returns the number of tiles in a row (ATLAS convention, starting at 1) of a module
+        constexpr std::size_t GetNumberOfTiles(Module module, std::size_t row) {
+            std::size_t n = 0;
+            for (const auto& cell : cell_vector) {
+                if (cell.module == module && cell.firstRow <= row && row <= cell.lastRow) {
+                    n += cell.nTilesRow[row - cell.firstRow];
+                }
+            }
+            return n;
+        }
+
+        // Returns the number of periods of a module parsable with row and tile indices,
+        // i.e. the number of tiles in its first row
+        constexpr std::size_t GetNumberOfPeriods(Module module) {
+            switch (module) {
+                case Module::LONG_LOWER:
+                case Module::LONG_UPPER:
+                case Module::EXTENDED:
+                    return GetNumberOfTiles(module, 1);
+                case Module::EXTENDED_C10:
+                case Module::EXTENDED_D4:
+                    break;
+            }
+            return 0;
+        }
+
+        namespace detail {
+
+            // Modules parsable with row and tile indices, in reverse index order
+            constexpr std::array<Module, 3> parsable_modules { Module::LONG_LOWER, Module::LONG_UPPER, Module::EXTENDED };
+
+            // Offset of a module in the reverse index
+            constexpr std::size_t GetReverseIndexOffset(Module module) {
+                std::size_t offset = 0;
+                for (auto parsable_module : parsable_modules) {
+                    if (parsable_module == module) break;
+                    offset += no_of_rows * GetNumberOfPeriods(parsable_module);
+                }
+                return offset;
+            }
+
+            // Size of the reverse index
+            constexpr std::size_t reverse_index_size = GetReverseIndexOffset(Module::EXTENDED_C10);
+
+            // Marker of unassigned entries in the reverse index
+            constexpr std::uint8_t reverse_index_unset = UINT8_MAX;
+            static_assert(no_of_cells < reverse_index_unset, "cell indices do not fit in the reverse index");
+
+            // Builds the module/row/tile -> cell index table from the cell vector,
+            // tiles are counted through the cells of a row in cell vector order
+            constexpr std::array<std::uint8_t, reverse_index_size> BuildReverseIndex() {
+                std::array<std::uint8_t, reverse_index_size> table {};
+                for (auto& entry : table) { entry = reverse_index_unset; }
+
+                for (auto module : parsable_modules) {
+                    const std::size_t offset = GetReverseIndexOffset(module);
+                    const std::size_t n_periods = GetNumberOfPeriods(module);
+                    std::array<std::size_t, no_of_rows> tile_counter {};
+                    for (std::size_t index = 0; index < no_of_cells; ++index) {
+                        const auto& cell = cell_vector[index];
+                        if (cell.module != module) continue;
+                        // Row indecies start with 1 in ATLAS convention
+                        for (std::size_t row = cell.firstRow; row <= cell.lastRow; ++row) {
+                            const std::size_t row_idx = row - 1;
+                            for (std::size_t tile = 0; tile < cell.nTilesRow[row - cell.firstRow]; ++tile) {
+                                table[offset + row_idx * n_periods + tile_counter[row_idx]] = static_cast<std::uint8_t>(index);
+                                ++tile_counter[row_idx];
+                            }
+                        }
+                    }
+                }
+                return table;
+            }
+
+            // Module/row/tile -> cell index table
+            inline constexpr std::array<std::uint8_t, reverse_index_size> reverse_index = BuildReverseIndex();
+
+            // Checks that the rows of a cell are consistent with its tile counts
+            constexpr bool CheckCellRows() {
+                for (const auto& cell : cell_vector) {
+                    if (cell.firstRow < 1 || cell.lastRow > no_of_rows || cell.firstRow > cell.lastRow) return false;
+                    if (cell.lastRow - cell.firstRow >= cell.nTilesRow.size()) return false;
+                    for (std::size_t n = cell.lastRow - cell.firstRow + 1; n < cell.nTilesRow.size(); ++n) {
+                        if (cell.nTilesRow[n] != 0) return false;
+                    }
+                }
+                return true;
+            }
+
+            // Checks that every row of a parsable module has as many tiles as the module has periods
+            constexpr bool CheckTilesPerRow() {
+                for (auto module : parsable_modules) {
+                    for (std::size_t row = 1; row <= no_of_rows; ++row) {
+                        if (GetNumberOfTiles(module, row) != GetNumberOfPeriods(module)) return false;
+                    }
+                }
+                return true;
+            }
+
+            // Checks that every module/row/tile triplet is assigned to a cell
+            constexpr bool CheckReverseIndex() {
+                for (auto entry : reverse_index) {
+                    if (entry == reverse_index_unset) return false;
+                }
+                return true;
+            }
+
+        }
+
+        // Finds the cell index given a module, the row index and the tile (period) index,
+        // returns invalid_cell_index if the indices are out of range
+        constexpr std::size_t FindCellIndex(Module module, std::size_t rowIdx, std::size_t tileIdx) {
+            switch (module) {
+                case Module::LONG_LOWER:
+                case Module::LONG_UPPER:
+                case Module::EXTENDED:
+                    break;
+                case Module::EXTENDED_C10:
+                case Module::EXTENDED_D4:
+                    // not parsable with rowIdx and tileIdx, return directly
+                    return GetFirstCellIndex(module);
+            }
+            const std::size_t n_periods = GetNumberOfPeriods(module);
+            if (rowIdx >= no_of_rows || tileIdx >= n_periods) return invalid_cell_index;
+            return detail::reverse_index[detail::GetReverseIndexOffset(module) + rowIdx * n_periods + tileIdx];
+        }
+
+        // Maximum number of neighbours of a cell
+        constexpr std::size_t max_neighbours = 12;
+
+        // Cells sharing a face with a cell
+        struct Neighbours {
+            std::array<std::uint8_t, max_neighbours> cells;
+            std::size_t size;
+
+            constexpr const std::uint8_t* begin() const { return cells.data(); }
+            constexpr const std::uint8_t* end() const { return cells.data() + size; }
+        };
+
+        namespace detail {
+
+            // Adds the link a <-> b once, size counts beyond max_neighbours to be caught by CheckNeighbours
+            constexpr void AddNeighbours(std::array<Neighbours, no_of_cells>& table, std::size_t a, std::size_t b) {
+                if (a == b) return;
+                for (std::size_t n = 0; n < table[a].size && n < max_neighbours; ++n) {
+                    if (table[a].cells[n] == b) return;
+                }
+                if (table[a].size < max_neighbours) table[a].cells[table[a].size] = static_cast<std::uint8_t>(b);
+                ++table[a].size;
+                if (table[b].size < max_neighbours) table[b].cells[table[b].size] = static_cast<std::uint8_t>(a);
+                ++table[b].size;
+            }
+
+            // Builds the neighbour table: cells of a module sharing a face in the row/tile grid,
+            // cells of the two long modules at the same row and tile (adjacent in phi) and
+            // the ITC cells with the extended module cells they face (A12, B11, D5),
+            // the extended module is not linked to the long modules
+            constexpr std::array<Neighbours, no_of_cells> BuildNeighbours() {
+                std::array<Neighbours, no_of_cells> table {};
+
+                for (auto module : parsable_modules) {
+                    const std::size_t n_periods = GetNumberOfPeriods(module);
+                    for (std::size_t row = 0; row < no_of_rows; ++row) {
+                        for (std::size_t tile = 0; tile < n_periods; ++tile) {
+                            const std::size_t index = reverse_index[GetReverseIndexOffset(module) + row * n_periods + tile];
+                            if (tile + 1 < n_periods) {
+                                AddNeighbours(table, index, reverse_index[GetReverseIndexOffset(module) + row * n_periods + tile + 1]);
+                            }
+                            if (row + 1 < no_of_rows) {
+                                AddNeighbours(table, index, reverse_index[GetReverseIndexOffset(module) + (row + 1) * n_periods + tile]);
+                            }
+                        }
+                    }
+                }
+
+                const std::size_t n_periods_long = GetNumberOfPeriods(Module::LONG_LOWER);
+                for (std::size_t entry = 0; entry < no_of_rows * n_periods_long; ++entry) {
+                    AddNeighbours(table, reverse_index[GetReverseIndexOffset(Module::LONG_LOWER) + entry],
+                                  reverse_index[GetReverseIndexOffset(Module::LONG_UPPER) + entry]);
+                }
+
+                const std::size_t n_periods_ext = GetNumberOfPeriods(Module::EXTENDED);
+                const std::size_t offset_ext = GetReverseIndexOffset(Module::EXTENDED);
+                const std::size_t c10 = GetFirstCellIndex(Module::EXTENDED_C10);
+                const std::size_t d4 = GetFirstCellIndex(Module::EXTENDED_D4);
+                const std::size_t a12 = reverse_index[offset_ext + 0 * n_periods_ext];
+                const std::size_t b11 = reverse_index[offset_ext + 3 * n_periods_ext];
+                const std::size_t d5 = reverse_index[offset_ext + 7 * n_periods_ext];
+                AddNeighbours(table, c10, d4);
+                AddNeighbours(table, c10, a12);
+                AddNeighbours(table, c10, b11);
+                AddNeighbours(table, d4, b11);
+                AddNeighbours(table, d4, d5);
+
+                return table;
+            }
+
+            // Cell index -> neighbours table
+            inline constexpr std::array<Neighbours, no_of_cells> neighbours = BuildNeighbours();
+
+            // Checks that every cell has 1 to max_neighbours neighbours and that the links are symmetric
+            constexpr bool CheckNeighbours() {
+                for (std::size_t index = 0; index < no_of_cells; ++index) {
+                    const auto& list = neighbours[index];
+                    if (list.size == 0 || list.size > max_neighbours) return false;
+                    for (auto neighbour : list) {
+                        bool found = false;
+                        for (auto back : neighbours[neighbour]) {
+                            if (back == index) found = true;
+                        }
+                        if (!found) return false;
+                    }
+                }
+                return true;
+            }
+
+        }
+
+        // Returns the neighbours of the cell corresponding to the cell index
+        constexpr const Neighbours& GetNeighbours(std::size_t index) { return detail::neighbours[index]; }
+
+        // Returns true if two cells share a face
+        constexpr bool AreNeighbours(std::size_t index, std::size_t other) {
+            for (auto neighbour : GetNeighbours(index)) {
+                if (neighbour == other) return true;
+            }
+            return false;
+        }
+
+        // Compile-time checks of the cell vector
+        static_assert(GetNumberOfCells(Module::LONG_LOWER) == 45, "wrong number of cells in the lower long module");
+        static_assert(GetNumberOfCells(Module::LONG_UPPER) == 45, "wrong number of cells in the upper long module");
+        static_assert(GetNumberOfCells(Module::EXTENDED) == 12, "wrong number of cells in the extended module");
+        static_assert(GetNumberOfCells(Module::EXTENDED_C10) == 1, "cell C10 must be unique");
+        static_assert(GetNumberOfCells(Module::EXTENDED_D4) == 1, "cell D4 must be unique");
+        static_assert(detail::CheckCellRows(), "first/last rows of a cell do not match its tile counts");
+        static_assert(detail::CheckTilesPerRow(), "tile counts per row do not add up to the periods of a module");
+        static_assert(detail::CheckReverseIndex(), "reverse index does not cover every tile");
+        static_assert(FindCellIndex(Module::LONG_LOWER, 0, 0) == 0, "first tile must belong to the first cell");
+        static_assert(FindCellIndex(Module::EXTENDED, no_of_rows - 1, GetNumberOfPeriods(Module::EXTENDED) - 1) == 101,
+                      "last extended tile must belong to cell D6");
+        static_assert(detail::CheckNeighbours(), "neighbour table overflows or is not symmetric");
+        static_assert(AreNeighbours(0, 1) && AreNeighbours(0, 20) && AreNeighbours(0, 45) && !AreNeighbours(0, 2),
+                      "cell A-10 must neighbour A-9, BC-9 and A-10 of the upper module only");
+
+    }
 
 }
 
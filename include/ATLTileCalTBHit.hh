@@ -12,20 +12,25 @@
 //Includers from project files
 //
 #include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBSignalBuffer.hh"
 
 //Includers from Geant4
 //
 #include "G4VHit.hh"
 #include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
 
 //Includers from C++
 //
 #include <array>
 
+//The binned signal of a hit is a view into the signal buffer
+//of its sensitive detector, it is valid until the next event begins
+//
 class ATLTileCalTBHit : public G4VHit {
-  
+
     public:
-        ATLTileCalTBHit();
+        ATLTileCalTBHit( ATLTileCalTBSignalBuffer* signalBuffer, std::size_t cellIndex );
         ATLTileCalTBHit( const ATLTileCalTBHit& );
         virtual ~ATLTileCalTBHit();
 
@@ -34,54 +39,98 @@ class ATLTileCalTBHit : public G4VHit {
         const ATLTileCalTBHit& operator=( const ATLTileCalTBHit& );
         G4bool operator==( const ATLTileCalTBHit& ) const;
 
+        //Operators (new and delete) using the per-thread allocator
+        //
+        inline void* operator new( std::size_t );
+        inline void  operator delete( void* );
+
         //Methods from base class
         //
         virtual void Draw() {}
         virtual void Print(){};
 
         //Method to get correct vector index from a given time
+        //(nominal binning of ATLTileCalTBConstants, used by the step records)
         static std::size_t GetBinFromTime( G4double time );
 
         //Methods to handle data
         //
         void AddEdep( G4double dEdep );
         void AddSdep( std::size_t index, G4double dSdepUp, G4double dSdepDown );
-        void AddSdep( G4double time, G4double dSdepUp, G4double dSdepDown );
+        void AddSdep( G4double time, G4double dSdepUp, G4double dSdepDown ); //ignored outside of the time window
 
         //Get methods
         //
         G4double GetEdep() const;
-        const std::array<G4double, ATLTileCalTBConstants::frames>& GetSdepUp() const;
-        const std::array<G4double, ATLTileCalTBConstants::frames>& GetSdepDown() const;
+        std::size_t GetCellIndex() const;
+        G4bool HasSdep() const;
+        //Binned signal of each PMT (ATLTileCalTBSignalBuffer::GetFrames() values, stride-1)
+        const ATLTileCalTBConstants::signal_t* GetSdepUp() const;
+        const ATLTileCalTBConstants::signal_t* GetSdepDown() const;
+        //Range [begin, end) of the filled time bins
+        std::size_t GetSdepBeginBin() const;
+        std::size_t GetSdepEndBin() const;
+        //Calls func(bin, up, down) for every filled time bin in ascending order
+        template<typename F> void ForEachSdepBin( F&& func ) const;
 
     private:
         // Total energy deposition in the cell
         G4double fEdep;
 
-        //Vectors containing the binned signal
-        std::array<G4double, ATLTileCalTBConstants::frames> fSdepUp;
-        std::array<G4double, ATLTileCalTBConstants::frames> fSdepDown;
+        //Signal buffer holding the binned signal and cell index in it
+        ATLTileCalTBSignalBuffer* fSignalBuffer;
+        std::size_t fCellIndex;
 
 };
 
 using ATLTileCalTBHitsCollection = G4THitsCollection<ATLTileCalTBHit>;
 
+extern G4ThreadLocal G4Allocator<ATLTileCalTBHit>* ATLTileCalTBHitAllocator;
+
+inline void* ATLTileCalTBHit::operator new( std::size_t ) {
+    if ( !ATLTileCalTBHitAllocator ) {
+        ATLTileCalTBHitAllocator = new G4Allocator<ATLTileCalTBHit>;
+    }
+    return (void*) ATLTileCalTBHitAllocator->MallocSingle();
+}
+
+inline void ATLTileCalTBHit::operator delete( void* hit ) {
+    ATLTileCalTBHitAllocator->FreeSingle( (ATLTileCalTBHit*) hit );
+}
+
 inline void ATLTileCalTBHit::AddEdep(G4double dEdep) { fEdep += dEdep; }
 
 inline void ATLTileCalTBHit::AddSdep(std::size_t index, G4double dSdepUp, G4double dSdepDown) {
-    fSdepUp[index] += dSdepUp;
-    fSdepDown[index] += dSdepDown;
+    fSignalBuffer->AddSdep(fCellIndex, index, dSdepUp, dSdepDown);
 }
 
 inline void ATLTileCalTBHit::AddSdep(G4double time, G4double dSdepUp, G4double dSdepDown) {
-    AddSdep(GetBinFromTime(time), dSdepUp, dSdepDown);
+    const std::size_t bin = fSignalBuffer->GetBin(time);
+    if ( bin < fSignalBuffer->GetFrames() ) AddSdep(bin, dSdepUp, dSdepDown);
 }
 
 inline G4double ATLTileCalTBHit::GetEdep() const { return fEdep; }
 
-inline const std::array<G4double, ATLTileCalTBConstants::frames>& ATLTileCalTBHit::GetSdepUp() const { return fSdepUp; }
+inline std::size_t ATLTileCalTBHit::GetCellIndex() const { return fCellIndex; }
+
+inline G4bool ATLTileCalTBHit::HasSdep() const { return GetSdepBeginBin() != GetSdepEndBin(); }
+
+inline const ATLTileCalTBConstants::signal_t* ATLTileCalTBHit::GetSdepUp() const { return fSignalBuffer->GetSdepUp(fCellIndex); }
+
+inline const ATLTileCalTBConstants::signal_t* ATLTileCalTBHit::GetSdepDown() const { return fSignalBuffer->GetSdepDown(fCellIndex); }
 
-inline const std::array<G4double, ATLTileCalTBConstants::frames>& ATLTileCalTBHit::GetSdepDown() const { return fSdepDown; }
+inline std::size_t ATLTileCalTBHit::GetSdepBeginBin() const { return fSignalBuffer->GetBeginBin(fCellIndex); }
+
+inline std::size_t ATLTileCalTBHit::GetSdepEndBin() const { return fSignalBuffer->GetEndBin(fCellIndex); }
+
+template<typename F>
+inline void ATLTileCalTBHit::ForEachSdepBin(F&& func) const {
+    const auto sdepUp = GetSdepUp();
+    const auto sdepDown = GetSdepDown();
+    for ( std::size_t bin = GetSdepBeginBin(); bin < GetSdepEndBin(); ++bin ) {
+        if ( sdepUp[bin] != 0. || sdepDown[bin] != 0. ) func(bin, sdepUp[bin], sdepDown[bin]);
+    }
+}
 
 #endif //ATLTileCalTBHit_h 1
 
@@ -0,0 +1,162 @@
+//**************************************************
+// \file ATLTileCalTBNtuple.hh
+// \brief: definition of ATLTileCalTBNtuple
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Event ntuple (ATLTileCalTBout) shared by ATLTileCalTB and
+// ATLTileCalTBReDigi: it books the columns, owns the cell vectors
+// bound to them and the digitization of the cell signals after the
+// nominal one (variants, sampled readout and topological clusters),
+// and fills one row per event. The column IDs are the ones returned
+// at booking. One instance per thread.
+
+#ifndef ATLTileCalTBNtuple_h
+#define ATLTileCalTBNtuple_h 1
+
+//Includers from project files
+//
+#include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBDigitizer.hh"
+#include "ATLTileCalTBOptimalFilter.hh"
+#include "ATLTileCalTBRandomBuffer.hh"
+#include "ATLTileCalTBTopoClustering.hh"
+
+//Includers from Geant4
+//
+#include "G4Types.hh"
+#include "G4SystemOfUnits.hh"
+
+//Includers from C++
+//
+#include <algorithm>
+#include <vector>
+
+class ATLTileCalTBNtuple {
+
+    public:
+        //Binned signal of a cell, returned by the signal(n) functions below
+        //
+        struct CellSignal {
+            const ATLTileCalTBConstants::signal_t* sdepUp;
+            const ATLTileCalTBConstants::signal_t* sdepDown;
+            std::size_t beginBin;
+            std::size_t endBin;
+        };
+
+        ATLTileCalTBNtuple();
+        ~ATLTileCalTBNtuple() = default;
+
+        //Create the ntuple, once per analysis manager
+        void Book();
+
+        //Time binning of the signal (digitizers of the variants and optimal filter)
+        void SetLayout( G4double binTime, std::size_t frames );
+        //Fill the Samples, OFAmplitude and OFTime columns (empty otherwise)
+        void SetSampledReadout( G4bool sampledReadout );
+        G4bool GetSampledReadout() const { return fSampledReadout; }
+        //Fill the Sdep_<name> columns of the digitization variants (empty otherwise)
+        void SetDigiVariants( G4bool digiVariants );
+        G4bool GetDigiVariants() const { return fDigiVariants; }
+        //Fill the Edep and Sdep columns (empty otherwise, the sums and clusters are always filled)
+        void SetCellOutput( G4bool cellOutput ) { fCellOutput = cellOutput; }
+        //Noise of the cell signals, the cluster thresholds are only applied with noise
+        void SetNoise( G4bool noise ) { fTopoClustering.SetNoise(noise); }
+
+        std::vector<G4double>& GetEdepVector() { return fEdepVector; }
+        std::vector<G4double>& GetSdepVector() { return fSdepVector; }
+        std::vector<G4double>& GetVariantSdepVector( std::size_t variant ) { return fVariantSdepVectors[variant]; }
+        const std::vector<ATLTileCalTBDigitizer>& GetVariantDigitizers() const { return fVariantDigitizers; }
+        const std::vector<std::size_t>& GetVariantWindowBins() const { return fVariantWindowBins; }
+        std::vector<G4float>& GetSamplesVector() { return fSamplesVector; }
+        std::vector<G4double>& GetOFAmplitudeVector() { return fOFAmplitudeVector; }
+        std::vector<G4double>& GetOFTimeVector() { return fOFTimeVector; }
+        const ATLTileCalTBOptimalFilter& GetOptimalFilter() const { return fOptimalFilter; }
+
+        //Signals of the digitization variants of all cells
+        template<typename SignalFunction>
+        void DigitizeVariants( SignalFunction signal, ATLTileCalTBRandomBuffer& random );
+        //Sampled readout and optimal filter reconstruction of all cells
+        template<typename SignalFunction>
+        void ReadoutCells( SignalFunction signal, ATLTileCalTBDigitizer& digitizer, G4double noiseSigma,
+                           ATLTileCalTBRandomBuffer& random );
+
+        //Fill a row from the scalars and the cell vectors (sums and clusters)
+        void Fill( G4double eLeak, G4double eCal, G4double eLate, G4int pdgID, G4double eBeam );
+
+    private:
+        std::size_t fNoOfCells;
+        std::vector<G4double> fEdepVector;
+        std::vector<G4double> fSdepVector;
+        //One digitizer (PMT response), time window and cell signals per variant
+        G4bool fDigiVariants;
+        std::vector<ATLTileCalTBDigitizer> fVariantDigitizers;
+        std::vector<std::size_t> fVariantWindowBins;
+        std::vector<std::vector<G4double>> fVariantSdepVectors;
+        //Sampled readout, readout_samples samples per PMT (cell x PMT x sample)
+        //and reconstructed amplitude and time (ns) per cell
+        ATLTileCalTBOptimalFilter fOptimalFilter;
+        G4bool fSampledReadout;
+        std::vector<G4float> fSamplesVector;
+        std::vector<G4double> fOFAmplitudeVector;
+        std::vector<G4double> fOFTimeVector;
+        //Topological clusters of the cell signals (energy, cells and seed cell index)
+        ATLTileCalTBTopoClustering fTopoClustering;
+        std::vector<G4double> fClusterEVector;
+        std::vector<G4int> fClusterNCellsVector;
+        std::vector<G4int> fClusterSeedVector;
+        G4bool fCellOutput;
+
+        //IDs of the ntuple and of the scalar columns
+        //
+        G4int fNtupleID;
+        G4int fELeakID;
+        G4int fEcalID;
+        G4int fEdepSumID;
+        G4int fSdepSumID;
+        G4int fPDGID;
+        G4int fEBeamID;
+        G4int fELateID;
+        std::vector<G4int> fVariantSdepSumIDs;
+
+};
+
+//DigitizeVariants method
+//
+template<typename SignalFunction>
+void ATLTileCalTBNtuple::DigitizeVariants( SignalFunction signal, ATLTileCalTBRandomBuffer& random ) {
+    if ( !fDigiVariants ) return;
+    for ( std::size_t v = 0; v < ATLTileCalTBConstants::digi_variants.size(); ++v ) {
+        const auto& variant = ATLTileCalTBConstants::digi_variants[v];
+        auto& sdepVector = fVariantSdepVectors[v];
+        for ( std::size_t n = 0; n < fNoOfCells; ++n ) {
+            const CellSignal cell = signal(n);
+            sdepVector[n] = fVariantDigitizers[v].GetCellSignal(cell.sdepUp, cell.sdepDown, cell.beginBin,
+                                                                std::min(cell.endBin, fVariantWindowBins[v]),
+                                                                variant.noise_sigma, variant.cut_multiple, random);
+        }
+    }
+}
+
+//ReadoutCells method
+//
+template<typename SignalFunction>
+void ATLTileCalTBNtuple::ReadoutCells( SignalFunction signal, ATLTileCalTBDigitizer& digitizer, G4double noiseSigma,
+                                       ATLTileCalTBRandomBuffer& random ) {
+    if ( !fSampledReadout ) return;
+    constexpr std::size_t cellSamples = 2 * ATLTileCalTBConstants::readout_samples;
+    for ( std::size_t n = 0; n < fNoOfCells; ++n ) {
+        const CellSignal cell = signal(n);
+        const auto result = fOptimalFilter.ReadoutCell(digitizer, cell.sdepUp, cell.sdepDown, cell.beginBin, cell.endBin,
+                                                       noiseSigma, random, fSamplesVector.data() + n * cellSamples);
+        fOFAmplitudeVector[n] = result.amplitude;
+        fOFTimeVector[n] = result.time / CLHEP::ns;
+    }
+}
+
+#endif //ATLTileCalTBNtuple_h
+
+//**************************************************
@@ -0,0 +1,90 @@
+//**************************************************
+// \file ATLTileCalTBOptimalFilter.hh
+// \brief: definition of ATLTileCalTBOptimalFilter
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Sampled readout of the PMT pulses (readout_samples samples every
+// readout_sample_period) and reconstruction of their amplitude and
+// time with an optimal filter (white noise, no pedestal):
+//   A = sum a_k S_k,   A * tau = sum b_k S_k,
+// the weights are tabulated for a grid of phases from the normalized
+// PMT response and its derivative, the reconstruction iterates
+// on the phase as in the ATLAS TileCal offline.
+// The amplitude is in the same units as the pulse peak of
+// ATLTileCalTBDigitizer::GetPeak(), the time is the time of the
+// signal from the start of the event.
+// It is constant after construction and can be shared by threads.
+
+#ifndef ATLTileCalTBOptimalFilter_h
+#define ATLTileCalTBOptimalFilter_h 1
+
+//Includers from project files
+//
+#include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBDigitizer.hh"
+#include "ATLTileCalTBRandomBuffer.hh"
+
+//Includers from Geant4
+//
+#include "G4Types.hh"
+
+//Includers from C++
+//
+#include <array>
+#include <vector>
+
+class ATLTileCalTBOptimalFilter {
+
+    public:
+        using Samples = std::array<G4double, ATLTileCalTBConstants::readout_samples>;
+
+        struct Result {
+            G4double amplitude;
+            G4double time;
+        };
+
+        //Optimal filter for the nominal PMT response and binning or for a given
+        //PMT response sampled every binTime (the same of ATLTileCalTBDigitizer)
+        ATLTileCalTBOptimalFilter();
+        ATLTileCalTBOptimalFilter( const std::vector<G4double>& kernel, G4double binTime );
+        ~ATLTileCalTBOptimalFilter() = default;
+
+        //Sample positions in units of time bins
+        const Samples& GetSamplePositions() const { return fSamplePositions; }
+
+        //Amplitude and time of a pulse from its samples, the time is 0
+        //if the amplitude is not above minAmplitude
+        Result Reconstruct( const G4double* samples, G4double minAmplitude ) const;
+
+        //Samples of both PMTs of a cell (up then down, with gaussian noise of
+        //noiseSigma per sample) and reconstructed cell amplitude (sum of the
+        //two PMTs) and time (amplitude-weighted mean of the two PMTs)
+        Result ReadoutCell( ATLTileCalTBDigitizer& digitizer, const ATLTileCalTBConstants::signal_t* sdepUp,
+                            const ATLTileCalTBConstants::signal_t* sdepDown, std::size_t begin, std::size_t end,
+                            G4double noiseSigma, ATLTileCalTBRandomBuffer& random, G4float* samples ) const;
+
+    private:
+        //Weights for a phase
+        struct Weights {
+            Samples amplitude;
+            Samples time;
+        };
+
+        //PMT response normalized to its maximum at a given time
+        G4double GetShape( G4double time ) const;
+
+        std::vector<G4double> fKernel;
+        G4double fBinTime;
+        Samples fSampleTimes;
+        Samples fSamplePositions;
+        std::vector<Weights> fWeights;
+
+};
+
+#endif //ATLTileCalTBOptimalFilter_h
+
+//**************************************************
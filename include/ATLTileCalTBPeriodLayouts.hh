@@ -0,0 +1,80 @@
+//**************************************************
+// \file ATLTileCalTBPeriodLayouts.hh
+// \brief: definition of ATLTileCalTBPeriodLayouts
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Tiles of the period logical volumes (Tile::Period) of the
+// geometry, used by the fast simulation models to find the tile
+// closest to a point of a period. In a period the x axis is the
+// period axis, y is along the tile and z is radial. The scintillator
+// copy number is the row and the scintillator is placed at the
+// center of its wrapper, so the scintillator local y is the period
+// y and the scintillator local z is the period z minus the tile z.
+
+#ifndef ATLTileCalTBPeriodLayouts_h
+#define ATLTileCalTBPeriodLayouts_h 1
+
+//Includers from Geant4
+//
+#include "G4Types.hh"
+
+//Includers from C++
+//
+#include <unordered_map>
+#include <vector>
+
+//Forward declaration from Geant4
+//
+class G4LogicalVolume;
+class G4VTouchable;
+
+class ATLTileCalTBPeriodLayouts {
+
+    public:
+        //Tile of a row in a period, position of its wrapper in the
+        //period and half lengths of its scintillator
+        //
+        struct Tile {
+            G4int row;
+            G4double x;
+            G4double z;
+            G4double yHalf;
+            G4double zHalf;
+        };
+        struct Layout {
+            G4double pitch;
+            std::vector<Tile> tiles;
+
+            //Tile of a row, nullptr if not in the period
+            const Tile* FindTile( G4int row ) const;
+            //Tile closest in z (the layout has at least one tile)
+            const Tile& FindClosestTile( G4double z ) const;
+            //Position along the period axis from a tile, in [0, 1)
+            G4double GetPhase( const Tile& tile, G4double x ) const;
+        };
+
+        //Layouts of the period logical volumes with tiles (geometry
+        //must be constructed)
+        ATLTileCalTBPeriodLayouts();
+
+        //Layout of a logical volume, nullptr if not a period
+        const Layout* Find( const G4LogicalVolume* volume ) const {
+            const auto layout = fLayouts.find( volume );
+            return ( layout != fLayouts.end() ) ? &layout->second : nullptr;
+        }
+        //Depth of the period with tiles (and a module 3 levels above) in the
+        //history of a touchable, -1 if the touchable is not in such a period
+        G4int FindPeriodDepth( const G4VTouchable* touchable ) const;
+
+    private:
+        std::unordered_map<const G4LogicalVolume*, Layout> fLayouts;
+
+};
+
+#endif //ATLTileCalTBPeriodLayouts_h
+
+//**************************************************
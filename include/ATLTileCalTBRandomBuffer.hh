@@ -0,0 +1,112 @@
+//**************************************************
+// \file ATLTileCalTBRandomBuffer.hh
+// \brief: definition of ATLTileCalTBRandomBuffer
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Per-thread buffer of random numbers for the digitization.
+// Uniforms are drawn in blocks with the engine flatArray and
+// gaussians are produced a block at a time (Box-Muller), the
+// photoelectron (Poisson) and noise (Gauss) sampling consume them.
+// The buffer must be reset whenever the engine is reseeded
+// (at the beginning of each event) to keep events reproducible.
+// The instance of a Geant4 thread draws from the engine of the
+// thread, other threads own a buffer on their own engine.
+
+#ifndef ATLTileCalTBRandomBuffer_h
+#define ATLTileCalTBRandomBuffer_h 1
+
+//Includers from Geant4
+//
+#include "G4Types.hh"
+#include "G4ThreadLocalSingleton.hh"
+
+//Includers from C++
+//
+#include <array>
+#include <cmath>
+
+//Forward declaration from CLHEP
+//
+namespace CLHEP { class HepRandomEngine; }
+
+class ATLTileCalTBRandomBuffer {
+
+    public:
+        //Return pointer to class instance (engine of the Geant4 thread)
+        static ATLTileCalTBRandomBuffer* GetInstance() {
+            static G4ThreadLocalSingleton<ATLTileCalTBRandomBuffer> instance{};
+            return instance.Instance();
+        }
+
+        //Buffer on the given engine (not owned), on the engine
+        //of the calling thread if nullptr
+        explicit ATLTileCalTBRandomBuffer( CLHEP::HepRandomEngine* engine = nullptr );
+
+        //Discard the buffered numbers
+        void Reset();
+
+        //Sampling methods
+        //
+        G4double Flat();
+        G4double Gauss( G4double mean, G4double sigma );
+        //Same algorithm as G4Poisson
+        G4long Poisson( G4double mean );
+
+    private:
+        //Refill the blocks from the engine
+        void FillFlat();
+        void FillGauss();
+
+        static constexpr std::size_t fBlockSize = 256;
+
+        CLHEP::HepRandomEngine* fEngine;
+        std::array<G4double, fBlockSize> fFlat;
+        std::size_t fNextFlat;
+        std::array<G4double, fBlockSize> fGauss;
+        std::size_t fNextGauss;
+
+    public:
+        ATLTileCalTBRandomBuffer(ATLTileCalTBRandomBuffer const&) = delete;
+        void operator=(ATLTileCalTBRandomBuffer const&) = delete;
+
+};
+
+inline G4double ATLTileCalTBRandomBuffer::Flat() {
+    if ( fNextFlat == fBlockSize ) FillFlat();
+    return fFlat[fNextFlat++];
+}
+
+inline G4double ATLTileCalTBRandomBuffer::Gauss( G4double mean, G4double sigma ) {
+    if ( fNextGauss == fBlockSize ) FillGauss();
+    return mean + sigma * fGauss[fNextGauss++];
+}
+
+inline G4long ATLTileCalTBRandomBuffer::Poisson( G4double mean ) {
+    const G4double border = 16.;
+    const G4double limit = 2e9;
+
+    if ( mean <= border ) {
+        const G4double position = Flat();
+        G4double poissonValue = std::exp(-mean);
+        G4double poissonSum = poissonValue;
+        G4long number = 0;
+        while ( poissonSum <= position ) {
+            ++number;
+            poissonValue *= mean / number;
+            poissonSum += poissonValue;
+        }
+        return number;
+    }
+
+    const G4double value = Gauss( mean, std::sqrt(mean) ) + 0.5;
+    if ( value <= 0. ) return 0;
+    return ( value >= limit ) ? G4long(limit) : G4long(value);
+}
+
+#endif //ATLTileCalTBRandomBuffer_h
+
+//**************************************************
@@ -13,10 +13,18 @@
 //Includers from Geant4
 //
 #include "G4UserRunAction.hh"
+#include "globals.hh"
+
+//Includers from C++
+//
+#include <vector>
 
 //Forward declaration from project
 //
 class ATLTileCalTBEventAction;
+class ATLTileCalTBRunMessenger;
+class ATLTileCalTBStackingAction;
+class ATLTileCalTBStepAction;
 
 //Forward declaration from Geant4
 //
@@ -25,14 +33,77 @@ class G4Run;
 class ATLTileCalTBRunAction : public G4UserRunAction {
   
     public:
-        ATLTileCalTBRunAction( ATLTileCalTBEventAction* eventAction );
+        ATLTileCalTBRunAction( ATLTileCalTBEventAction* eventAction, ATLTileCalTBStackingAction* stackingAction = nullptr,
+                               ATLTileCalTBStepAction* stepAction = nullptr );
         virtual ~ATLTileCalTBRunAction();
 
         virtual void BeginOfRunAction(const G4Run*);
         virtual void EndOfRunAction(const G4Run*);
 
+        //Digitization and output modes of the next run (see ATLTileCalTBRunMessenger)
+        void SetNoise( G4bool noise ) { fNoise = noise; }
+        void SetPulseOutput( G4bool pulseOutput ) { fPulseOutput = pulseOutput; }
+        void SetLeakAnalysis( G4bool leakAnalysis ) { fLeakAnalysis = leakAnalysis; }
+        void SetDigiPreset( const G4String& digiPreset ) { fDigiPreset = digiPreset; }
+        void SetTimeProfile( G4bool timeProfile ) { fTimeProfile = timeProfile; }
+        void SetDigiThreads( G4int digiThreads ) { fDigiThreads = digiThreads; }
+        void SetSampledReadout( G4bool sampledReadout ) { fSampledReadout = sampledReadout; }
+        void SetCellOutput( G4bool cellOutput ) { fCellOutput = cellOutput; }
+        void SetDigiVariants( G4bool digiVariants ) { fDigiVariants = digiVariants; }
+        void SetTimeCut( G4bool timeCut ) { fTimeCut = timeCut; }
+        //Russian roulette on the new tracks of a particle below a kinetic energy threshold
+        //(replaces the one of the same particle), ClearRoulette() disables it for all particles
+        void AddRoulette( const G4String& particle, G4double threshold, G4double survival );
+        void ClearRoulette() { fRoulette.clear(); }
+        //Particles killed at creation as leaking (default ATLTileCalTBConstants::non_interacting_particles)
+        void AddNonInteracting( const G4String& particle ) { fNonInteracting.push_back(particle); }
+        void ClearNonInteracting() { fNonInteracting.clear(); }
+        //Base name of the shower library files written in generation mode, empty if disabled
+        void SetLibraryFile( const G4String& libraryFile ) { fLibraryFile = libraryFile; }
+        //Fit the parameterized EM showers to the full-sim showers of the primary e+- (default false)
+        void SetEmShowerTuning( G4bool emShowerTuning ) { fEmShowerTuning = emShowerTuning; }
+        G4bool GetNoise() const { return fNoise; }
+        G4bool GetPulseOutput() const { return fPulseOutput; }
+        G4bool GetLeakAnalysis() const { return fLeakAnalysis; }
+        const G4String& GetDigiPreset() const { return fDigiPreset; }
+        G4bool GetTimeProfile() const { return fTimeProfile; }
+        G4int GetDigiThreads() const { return fDigiThreads; }
+        G4bool GetSampledReadout() const { return fSampledReadout; }
+        G4bool GetCellOutput() const { return fCellOutput; }
+        G4bool GetDigiVariants() const { return fDigiVariants; }
+        G4bool GetTimeCut() const { return fTimeCut; }
+        const G4String& GetLibraryFile() const { return fLibraryFile; }
+        G4bool GetEmShowerTuning() const { return fEmShowerTuning; }
+
     private:
         ATLTileCalTBEventAction* fEventAction;
+        ATLTileCalTBStackingAction* fStackingAction;
+        ATLTileCalTBStepAction* fStepAction;
+        ATLTileCalTBRunMessenger* fMessenger;
+        G4bool fNoise;
+        G4bool fPulseOutput;
+        G4bool fLeakAnalysis;
+        G4String fDigiPreset;
+        G4bool fTimeProfile;
+        G4int fDigiThreads;
+        G4bool fSampledReadout;
+        G4bool fCellOutput;
+        G4bool fDigiVariants;
+        G4bool fTimeCut;
+        struct Roulette {
+            G4String particle;
+            G4double threshold;
+            G4double survival;
+        };
+        std::vector<Roulette> fRoulette;
+        std::vector<G4String> fNonInteracting;
+        G4String fLibraryFile;
+        G4bool fEmShowerTuning;
+        G4int fSpectrumNtupleID;
+        G4int fSignalTimeH1ID;
+        G4int fRunInfoNtupleID;
+        //Set by the master, shared with the workers
+        static G4long fRunSeed;
 
 };
 
@@ -0,0 +1,86 @@
+//**************************************************
+// \file ATLTileCalTBRunMessenger.hh
+// \brief: definition of ATLTileCalTBRunMessenger
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// UI commands selecting the digitization and output modes
+// of the next run (/tiletb/digi/, /tiletb/output/, /tiletb/tracking/)
+// and the EM parameters preset (/tiletb/physics/).
+
+#ifndef ATLTileCalTBRunMessenger_h
+#define ATLTileCalTBRunMessenger_h 1
+
+//Includers from Geant4
+//
+#include "G4UImessenger.hh"
+
+//Forward declaration from project
+//
+class ATLTileCalTBRunAction;
+
+//Forward declaration from Geant4
+//
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithoutParameter;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcommand;
+
+class ATLTileCalTBRunMessenger : public G4UImessenger {
+
+    public:
+        ATLTileCalTBRunMessenger( ATLTileCalTBRunAction* runAction );
+        virtual ~ATLTileCalTBRunMessenger();
+
+        virtual void SetNewValue( G4UIcommand* command, G4String newValue );
+        virtual G4String GetCurrentValue( G4UIcommand* command );
+
+    private:
+        ATLTileCalTBRunAction* fRunAction;
+
+        G4UIdirectory* fTileTBDir;
+        G4UIdirectory* fDigiDir;
+        G4UIdirectory* fOutputDir;
+        G4UIdirectory* fTrackingDir;
+        G4UIdirectory* fPhysicsDir;
+        #ifdef ATLTileCalTB_FastSim
+        G4UIdirectory* fLibraryDir;
+        G4UIdirectory* fEmShowerDir;
+        #endif
+
+        G4UIcmdWithABool* fNoiseCmd;
+        G4UIcmdWithAString* fDigiPresetCmd;
+        G4UIcmdWithAnInteger* fDigiThreadsCmd;
+        G4UIcmdWithABool* fDigiVariantsCmd;
+        G4UIcmdWithABool* fPulseOutputCmd;
+        G4UIcmdWithABool* fLeakAnalysisCmd;
+        G4UIcmdWithABool* fTimeProfileCmd;
+        G4UIcmdWithABool* fSampledReadoutCmd;
+        G4UIcmdWithABool* fCellOutputCmd;
+        G4UIcmdWithABool* fTimeCutCmd;
+        G4UIcommand* fRouletteCmd;
+        G4UIcmdWithoutParameter* fClearRouletteCmd;
+        G4UIcmdWithAString* fNonInteractingCmd;
+        G4UIcmdWithoutParameter* fClearNonInteractingCmd;
+        G4UIcmdWithAString* fEmPresetCmd;
+        #ifdef ATLTileCalTB_FastSim
+        G4UIcmdWithAString* fLibraryLoadCmd;
+        G4UIcmdWithoutParameter* fLibraryClearCmd;
+        G4UIcmdWithADoubleAndUnit* fLibraryMaxEnergyCmd;
+        G4UIcmdWithAString* fLibraryGenerateCmd;
+        G4UIcmdWithABool* fEmShowerEnableCmd;
+        G4UIcommand* fEmShowerParametersCmd;
+        G4UIcmdWithABool* fEmShowerTuneCmd;
+        #endif
+
+};
+
+#endif //ATLTileCalTBRunMessenger_h
+
+//**************************************************
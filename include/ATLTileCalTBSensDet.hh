@@ -16,12 +16,24 @@
 //Includers form project files
 //
 #include "ATLTileCalTBHit.hh"
+#include "ATLTileCalTBSignalBuffer.hh"
 #include "ATLTileCalTBGeometry.hh"
+#include "ATLTileCalTBRandomBuffer.hh"
+
+//Includers from C++
+//
+#include <cstdint>
+#include <vector>
+
+//Forward declaration from project
+//
+class ATLTileCalTBEventAction;
 
 //Forward declaration from Geant4
 //
 class G4Step;
 class G4HCofThisEvent;
+class G4VPhysicalVolume;
 
 class ATLTileCalTBSensDet : public G4VSensitiveDetector {
   
@@ -35,11 +47,56 @@ class ATLTileCalTBSensDet : public G4VSensitiveDetector {
         virtual G4bool ProcessHits( G4Step* aStep, G4TouchableHistory* history );
         virtual void   EndOfEvent( G4HCofThisEvent* hitCollection );
 
+        //Register a module physical volume and build its
+        //(scintillator, period) -> cell lookup table
+        //
+        void AddModuleVolume( const G4VPhysicalVolume* moduleVolume, ATLTileCalTBGeometry::Module module );
+
+        //Time binning of the signal (set at the beginning of each run)
+        void SetLayout( G4double binTime, G4double timeWindow ) { fSignalBuffer.SetLayout(binTime, timeWindow); }
+
+        //Deposit of a fast simulation model in the scintillator of a row and period
+        //of a registered module, the visible energy is the one after Birk's law
+        //(weighted energies, Ecal is collected by the model), false if the
+        //tile is not part of a cell or the deposit is out of the time window
+        //
+        G4bool AddFastDeposit( const G4VPhysicalVolume* moduleVolume, G4int row, G4int period, G4double time,
+                               G4double yLocal, G4double zLocal, G4double edep, G4double visibleEnergy );
+        //Number of periods of a registered module, 0 if not registered or
+        //not parsable with the period copy number (cells C10 and D4)
+        std::size_t GetNumberOfPeriods( const G4VPhysicalVolume* moduleVolume ) const;
+
     private:
+        //Cell index and U-shape profile row of a scintillator tile
+        //(kept compact so that the lookup tables stay in cache)
+        //
+        struct CellEntry {
+            std::uint16_t cellIndex;
+            std::uint16_t profileRow;
+        };
+
+        //Lookup table of a module physical volume, entries are
+        //indexed by scintillator copy number * nPeriods + period copy number
+        //
+        struct ModuleTable {
+            const G4VPhysicalVolume* volume;
+            std::size_t nPeriods;
+            std::vector<CellEntry> entries;
+        };
+
+        //Marker of (scintillator, period) pairs not belonging to any cell
+        static constexpr std::uint16_t fInvalidCell = UINT16_MAX;
+
         ATLTileCalTBHitsCollection* fHitsCollection;
+        ATLTileCalTBSignalBuffer fSignalBuffer;
+        ATLTileCalTBRandomBuffer* fRandomBuffer;
+        //Adds the scintillator energy to Ecal, nullptr if Ecal is collected by ATLTileCalTBStepAction
+        ATLTileCalTBEventAction* fEventAction;
+        std::vector<ModuleTable> fModuleTables;
         G4double BirkLaw( const G4Step* aStep) const;
-        std::size_t FindCellIndexFromG4( const G4Step* aStep ) const;
-        G4double Tile_1D_profileRescaled( G4int row, G4double x, G4double y, G4int PMT, ATLTileCalTBGeometry::Cell cell/*, G4int nSide*/);
+        CellEntry FindCellEntry( const G4VPhysicalVolume* moduleVolume, std::size_t scintillatorCopyNo, std::size_t periodCopyNo ) const;
+        CellEntry FindCellEntryFromG4( const G4Step* aStep ) const;
+        void ApplyUShape( const CellEntry& cellEntry, std::size_t bin, G4double yLocal, G4double zLocal, G4double visibleEnergy );
 
 };
 
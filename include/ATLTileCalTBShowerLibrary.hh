@@ -0,0 +1,227 @@
+//**************************************************
+// \file ATLTileCalTBShowerLibrary.hh
+// \brief: definition of ATLTileCalTBShowerLibrary
+//         classes
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Library of the sub-showers of low-energy e+-/gamma in the
+// periods of the Tile modules, used by the fast simulation
+// model ATLTileCalTBShowerLibraryModel. The library file is a
+// header followed by entries, each entry is an
+// ATLTileCalTBShowerLibraryEntry followed by its nSpots
+// ATLTileCalTBShowerLibrarySpot. The entries are written by the
+// ATLTileCalTBShowerRecorder (one file per thread) when the
+// application runs in generation mode (/tiletb/library/generate)
+// and loaded by ATLTileCalTBShowerLibrary (/tiletb/library/load).
+// Only built with the ATLTileCalTB_FastSim compiler definition.
+
+#ifndef ATLTileCalTBShowerLibrary_h
+#define ATLTileCalTBShowerLibrary_h 1
+
+//Includers from Geant4
+//
+#include "G4Types.hh"
+#include "G4String.hh"
+#include "G4ThreadLocalSingleton.hh"
+
+//Includers from C++
+//
+#include <cstdint>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+//Forward declaration from Geant4
+//
+class G4Track;
+class G4VPhysicalVolume;
+
+//File header
+//
+struct ATLTileCalTBShowerLibraryHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t spotSize;
+};
+
+//Entry header: sub-shower of a particle starting in a period at the
+//given scintillator row and phase bin (position along the period axis
+//from the tile of the row), energies in MeV
+//
+struct ATLTileCalTBShowerLibraryEntry {
+    std::uint8_t particleClass;
+    std::uint8_t row;
+    std::uint8_t phaseBin;
+    std::uint8_t reserved;
+    G4float energy;
+    G4float eCal;
+    G4float eLeak;
+    std::uint32_t nSpots;
+};
+
+//Scintillator deposits of an entry in a tile, relative to the start
+//period, row, y (along the tile) and time of the particle, the z
+//position is the one in the tile. Positions are edep-weighted means,
+//lengths in mm, times in ns and energies in MeV
+//
+struct ATLTileCalTBShowerLibrarySpot {
+    std::int16_t dPeriod;
+    std::int16_t dRow;
+    G4float dy;
+    G4float zLocal;
+    G4float dt;
+    G4float edep;
+    G4float visibleEnergy;
+};
+
+static_assert(std::is_trivially_copyable_v<ATLTileCalTBShowerLibraryEntry>, "Library entries are written as raw bytes");
+static_assert(std::is_trivially_copyable_v<ATLTileCalTBShowerLibrarySpot>, "Library spots are written as raw bytes");
+static_assert(sizeof(ATLTileCalTBShowerLibrarySpot) == 24, "Library spot layout changed, bump the file version");
+
+namespace ATLTileCalTBShowerLibraryFile {
+
+    constexpr char magic[8] = { 'A', 'T', 'L', 'T', 'B', 'S', 'H', 'L' };
+    constexpr std::uint32_t version = 2;
+
+    //Check the header of a library file
+    G4bool IsValidHeader( const ATLTileCalTBShowerLibraryHeader& header );
+
+    //Particle classes of the entries
+    enum class ParticleClass : std::uint8_t { ELECTRON, POSITRON, GAMMA, NONE };
+    constexpr std::size_t no_of_particle_classes = 3;
+    ParticleClass GetParticleClass( const G4Track* track );
+
+    //Bins of the library, no_bin if out of the energy range
+    constexpr std::size_t no_bin = SIZE_MAX;
+    std::size_t GetEnergyBin( G4double energy );
+    std::size_t GetBin( ParticleClass particleClass, std::size_t row, std::size_t phaseBin, std::size_t energyBin );
+    std::size_t GetNumberOfBins();
+
+}
+
+//Library loaded by the master thread and shared (read-only) by all threads
+//
+class ATLTileCalTBShowerLibrary {
+
+    public:
+        //Return pointer to class instance
+        static ATLTileCalTBShowerLibrary* GetInstance() {
+            static ATLTileCalTBShowerLibrary instance{};
+            return &instance;
+        }
+
+        //Add the entries of a library file, return false if it can not be read
+        G4bool Load( const G4String& fileName );
+        void Clear();
+        G4bool IsEmpty() const { return fEntries.empty(); }
+        std::size_t GetNumberOfEntries() const { return fEntries.size(); }
+
+        //Maximum kinetic energy of the particles replaced by a library entry
+        void SetMaxEnergy( G4double maxEnergy ) { fMaxEnergy = maxEnergy; }
+        G4double GetMaxEnergy() const { return fMaxEnergy; }
+
+        //Random entry of the bin of the particle (or of the closest
+        //energy bin with entries), nullptr if there is none
+        //
+        struct Sample {
+            const ATLTileCalTBShowerLibraryEntry* entry;
+            const ATLTileCalTBShowerLibrarySpot* spots;
+        };
+        Sample GetSample( ATLTileCalTBShowerLibraryFile::ParticleClass particleClass, std::size_t row,
+                          std::size_t phaseBin, G4double energy ) const;
+
+    private:
+        //Private constructor
+        ATLTileCalTBShowerLibrary();
+
+        std::vector<ATLTileCalTBShowerLibraryEntry> fEntries;
+        std::vector<std::size_t> fSpotOffsets;
+        std::vector<ATLTileCalTBShowerLibrarySpot> fSpots;
+        //Entry indices of each bin
+        std::vector<std::vector<std::uint32_t>> fBins;
+        G4double fMaxEnergy;
+
+    public:
+        ATLTileCalTBShowerLibrary(ATLTileCalTBShowerLibrary const&) = delete;
+        void operator=(ATLTileCalTBShowerLibrary const&) = delete;
+
+};
+
+//Per-thread writer of the library file (generation mode): the e+-/gamma
+//tagged as roots by ATLTileCalTBShowerLibraryModel and their descendants
+//are followed, their deposits are written at the end of the event
+//
+class ATLTileCalTBShowerRecorder {
+
+    friend class G4ThreadLocalSingleton<ATLTileCalTBShowerRecorder>;
+
+    public:
+        //Return pointer to class instance
+        static ATLTileCalTBShowerRecorder* GetInstance() {
+            static G4ThreadLocalSingleton<ATLTileCalTBShowerRecorder> instance{};
+            return instance.Instance();
+        }
+
+        //Run-wise methods
+        //
+        void OpenFile( const G4String& fileName );
+        void CloseFile();
+        G4bool IsOpen() const { return fFile.is_open(); }
+
+        //Track-wise methods
+        //
+        //Start an entry from a track, false if its bin is full
+        G4bool AddRoot( const G4Track* track, ATLTileCalTBShowerLibraryFile::ParticleClass particleClass,
+                        const G4VPhysicalVolume* moduleVolume, G4int period, G4int row, std::size_t phaseBin, G4double yLocal );
+        G4bool IsFollowed( const G4Track* track ) const;
+        //Follow a new track if its parent is followed
+        void AddTrack( const G4Track* track );
+
+        //Step-wise methods (weighted energies)
+        //
+        void AddDeposit( const G4Track* track, const G4VPhysicalVolume* moduleVolume, G4int period, G4int row,
+                         G4double time, G4double yLocal, G4double zLocal, G4double edep, G4double visibleEnergy );
+        void AddEcal( const G4Track* track, G4double edep );
+        //Energy leaking out of the world (or killed at creation as leaking)
+        void AddLeak( const G4Track* track, G4double energy );
+
+        //Event-wise methods
+        //
+        void WriteEvent();
+
+    private:
+        //Private constructor
+        ATLTileCalTBShowerRecorder() = default;
+
+        struct Root {
+            ATLTileCalTBShowerLibraryEntry entry;
+            const G4VPhysicalVolume* moduleVolume;
+            G4int period;
+            G4int row;
+            G4double yLocal;
+            G4double time;
+            G4double weight;
+            //Spots by (dPeriod, dRow), sums of edep-weighted positions and times
+            std::unordered_map<std::uint32_t, ATLTileCalTBShowerLibrarySpot> spots;
+        };
+        Root* FindRoot( const G4Track* track );
+
+        std::ofstream fFile;
+        std::vector<Root> fRoots;
+        std::unordered_map<G4int, std::size_t> fRootOfTrack;
+        //Entries (written or in this event) of each bin
+        std::vector<std::size_t> fBinEntries;
+
+    public:
+        ATLTileCalTBShowerRecorder(ATLTileCalTBShowerRecorder const&) = delete;
+        void operator=(ATLTileCalTBShowerRecorder const&) = delete;
+
+};
+
+#endif //ATLTileCalTBShowerLibrary_h
+
+//**************************************************
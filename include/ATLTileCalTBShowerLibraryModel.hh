@@ -0,0 +1,68 @@
+//**************************************************
+// \file ATLTileCalTBShowerLibraryModel.hh
+// \brief: definition of ATLTileCalTBShowerLibraryModel
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Fast simulation model replacing the e+-/gamma entering a period of
+// a Tile module, with a kinetic energy in the range of the shower
+// library, by an entry of ATLTileCalTBShowerLibrary. The scintillator
+// deposits of the entry (scaled to the energy of the particle, visible
+// energy included) are added with ATLTileCalTBSensDet::AddFastDeposit(),
+// its calo energy to Ecal and its leakage to ELeak. In generation mode
+// (shower recorder open) the particles are tagged as roots of new
+// entries instead and fully simulated. One instance per thread.
+
+#ifndef ATLTileCalTBShowerLibraryModel_h
+#define ATLTileCalTBShowerLibraryModel_h 1
+
+//Includers from project files
+//
+#include "ATLTileCalTBShowerLibrary.hh"
+#include "ATLTileCalTBPeriodLayouts.hh"
+
+//Includers from Geant4
+//
+#include "G4VFastSimulationModel.hh"
+
+//Forward declaration from project
+//
+class ATLTileCalTBSensDet;
+
+//Forward declaration from Geant4
+//
+class G4Region;
+
+class ATLTileCalTBShowerLibraryModel : public G4VFastSimulationModel {
+
+    public:
+        ATLTileCalTBShowerLibraryModel( const G4String& name, G4Region* region, ATLTileCalTBSensDet* sensDet );
+        virtual ~ATLTileCalTBShowerLibraryModel();
+
+        //Methods from base class
+        //
+        virtual G4bool IsApplicable( const G4ParticleDefinition& particle );
+        virtual G4bool ModelTrigger( const G4FastTrack& fastTrack );
+        virtual void DoIt( const G4FastTrack& fastTrack, G4FastStep& fastStep );
+
+    private:
+        ATLTileCalTBSensDet* fSensDet;
+        ATLTileCalTBPeriodLayouts fPeriodLayouts;
+
+        //Start point and library entry of the triggered track
+        //
+        const G4VPhysicalVolume* fModuleVolume;
+        const ATLTileCalTBPeriodLayouts::Layout* fPeriodLayout;
+        G4int fPeriod;
+        G4int fRow;
+        G4double fYLocal;
+        ATLTileCalTBShowerLibrary::Sample fSample;
+
+};
+
+#endif //ATLTileCalTBShowerLibraryModel_h
+
+//**************************************************
@@ -0,0 +1,125 @@
+//**************************************************
+// \file ATLTileCalTBSignalBuffer.hh
+// \brief: definition of ATLTileCalTBSignalBuffer
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Per-thread contiguous buffer of the binned signal of all
+// cells, laid out as cell x PMT x time bin. It is allocated
+// once per sensitive detector (i.e. per thread) and only the
+// regions touched during an event are cleared at the next one.
+// The time binning (bin width and window) is set per run from
+// the presets of ATLTileCalTBConstants.
+
+#ifndef ATLTileCalTBSignalBuffer_h
+#define ATLTileCalTBSignalBuffer_h 1
+
+//Includers from project files
+//
+#include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBGeometry.hh"
+
+//Includers from C++
+//
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+class ATLTileCalTBSignalBuffer {
+
+    public:
+        ATLTileCalTBSignalBuffer();
+        ~ATLTileCalTBSignalBuffer() = default;
+
+        ATLTileCalTBSignalBuffer(ATLTileCalTBSignalBuffer const&) = delete;
+        void operator=(ATLTileCalTBSignalBuffer const&) = delete;
+
+        //Clear the regions filled in the previous event
+        void Reset();
+
+        //Set the time binning, clears the buffer
+        void SetLayout( G4double binTime, G4double timeWindow );
+
+        //Time bin of a given time (GetFrames() if outside of the window)
+        std::size_t GetBin( G4double time ) const;
+
+        //Add signal of both PMTs of a cell in a time bin
+        void AddSdep( std::size_t cellIndex, std::size_t bin, G4double dSdepUp, G4double dSdepDown );
+
+        //Get methods
+        //
+        std::size_t GetFrames() const { return fFrames; }
+        G4double GetBinTime() const { return fBinTime; }
+        G4double GetTimeWindow() const { return fTimeWindow; }
+        //Binned signal of a PMT (GetFrames() values, stride-1)
+        const ATLTileCalTBConstants::signal_t* GetSdepUp( std::size_t cellIndex ) const;
+        const ATLTileCalTBConstants::signal_t* GetSdepDown( std::size_t cellIndex ) const;
+        //Range [begin, end) of the filled time bins of a cell, empty if untouched
+        std::size_t GetBeginBin( std::size_t cellIndex ) const;
+        std::size_t GetEndBin( std::size_t cellIndex ) const;
+        //Cells filled in this event, in order of first deposit
+        const std::vector<std::size_t>& GetDirtyCells() const;
+
+    private:
+        //Number of PMTs per cell
+        static constexpr std::size_t fNoOfPMTs = 2;
+
+        //Time binning
+        G4double fBinTime;
+        G4double fTimeWindow;
+        std::size_t fFrames;
+
+        //Binned signal, cell x PMT (up, down) x time bin
+        std::vector<ATLTileCalTBConstants::signal_t> fSdep;
+
+        //Filled time bins per cell
+        std::array<std::size_t, ATLTileCalTBGeometry::CellLUT::no_of_cells> fBeginBin;
+        std::array<std::size_t, ATLTileCalTBGeometry::CellLUT::no_of_cells> fEndBin;
+
+        //Cells filled in this event
+        std::vector<std::size_t> fDirtyCells;
+
+};
+
+inline void ATLTileCalTBSignalBuffer::AddSdep( std::size_t cellIndex, std::size_t bin, G4double dSdepUp, G4double dSdepDown ) {
+    auto sdep = fSdep.data() + cellIndex * fNoOfPMTs * fFrames;
+    sdep[bin] += dSdepUp;
+    sdep[fFrames + bin] += dSdepDown;
+
+    if ( fBeginBin[cellIndex] == fEndBin[cellIndex] ) {
+        fDirtyCells.push_back(cellIndex);
+        fBeginBin[cellIndex] = bin;
+        fEndBin[cellIndex] = bin + 1;
+    }
+    else {
+        fBeginBin[cellIndex] = std::min(fBeginBin[cellIndex], bin);
+        fEndBin[cellIndex] = std::max(fEndBin[cellIndex], bin + 1);
+    }
+}
+
+inline const ATLTileCalTBConstants::signal_t* ATLTileCalTBSignalBuffer::GetSdepUp( std::size_t cellIndex ) const {
+    return fSdep.data() + cellIndex * fNoOfPMTs * fFrames;
+}
+
+inline const ATLTileCalTBConstants::signal_t* ATLTileCalTBSignalBuffer::GetSdepDown( std::size_t cellIndex ) const {
+    return fSdep.data() + (cellIndex * fNoOfPMTs + 1) * fFrames;
+}
+
+inline std::size_t ATLTileCalTBSignalBuffer::GetBin( G4double time ) const {
+    if ( time < 0. || time >= fTimeWindow ) return fFrames;
+    return std::min(static_cast<std::size_t>(std::ceil(time / fBinTime)), fFrames);
+}
+
+inline std::size_t ATLTileCalTBSignalBuffer::GetBeginBin( std::size_t cellIndex ) const { return fBeginBin[cellIndex]; }
+
+inline std::size_t ATLTileCalTBSignalBuffer::GetEndBin( std::size_t cellIndex ) const { return fEndBin[cellIndex]; }
+
+inline const std::vector<std::size_t>& ATLTileCalTBSignalBuffer::GetDirtyCells() const { return fDirtyCells; }
+
+#endif //ATLTileCalTBSignalBuffer_h
+
+//**************************************************
@@ -0,0 +1,75 @@
+//**************************************************
+// \file ATLTileCalTBStackingAction.hh
+// \brief: definition of ATLTileCalTBStackingAction
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Kills the tracks created after the time cut of the run
+// (ATLTileCalTBEventAction::GetTimeCut()), e.g. the gammas of
+// late neutron captures, as they cannot contribute to the
+// signal. Their kinetic energy is added to ELate.
+// The non-interacting particles (neutrinos by default) are killed
+// at creation and their kinetic energy is added to ELeak (and to
+// the leakage spectra), as they would leave the world unchanged
+// after being navigated through the whole geometry.
+// Optionally plays Russian roulette on the new secondaries of
+// the given particles below an energy threshold (e.g. the low
+// energy neutrons and gammas of hadronic showers): they survive
+// with the given probability and their weight is divided by it.
+// The weight is used by all the energy scorers.
+
+#ifndef ATLTileCalTBStackingAction_h
+#define ATLTileCalTBStackingAction_h 1
+
+//Includers from Geant4
+//
+#include "G4UserStackingAction.hh"
+
+//Includers from C++
+//
+#include <vector>
+
+//Forward declaration from project
+//
+class ATLTileCalTBEventAction;
+
+//Forward declaration from Geant4
+//
+class G4ParticleDefinition;
+
+class ATLTileCalTBStackingAction : public G4UserStackingAction {
+
+    public:
+        ATLTileCalTBStackingAction( ATLTileCalTBEventAction* eventAction );
+        virtual ~ATLTileCalTBStackingAction();
+
+        virtual G4ClassificationOfNewTrack ClassifyNewTrack( const G4Track* aTrack );
+
+        //Particles killed at creation as leaking
+        void AddNonInteracting( const G4ParticleDefinition* particle ) { fNonInteracting.push_back(particle); }
+        void ClearNonInteracting() { fNonInteracting.clear(); }
+
+        //Russian roulette on the secondaries of a particle below a kinetic energy threshold,
+        //survival probability in (0, 1]
+        void AddRoulette( const G4ParticleDefinition* particle, G4double threshold, G4double survival );
+        void ClearRoulette() { fRoulette.clear(); }
+
+    private:
+        ATLTileCalTBEventAction* fEventAction;
+        std::vector<const G4ParticleDefinition*> fNonInteracting;
+
+        struct Roulette {
+            const G4ParticleDefinition* particle;
+            G4double threshold;
+            G4double survival;
+        };
+        std::vector<Roulette> fRoulette;
+
+};
+
+#endif //ATLTileCalTBStackingAction_h
+
+//**************************************************
@@ -18,6 +18,11 @@
 //Includers from project files
 //
 #include "ATLTileCalTBEventAction.hh"
+#include "ATLTileCalTBGeometry.hh"
+
+//Includers from C++
+//
+#include <vector>
 
 class ATLTileCalTBStepAction: public G4UserSteppingAction {
 
@@ -26,9 +31,14 @@ class ATLTileCalTBStepAction: public G4UserSteppingAction {
         virtual ~ATLTileCalTBStepAction();
 
         virtual void UserSteppingAction( const G4Step* aStep );
+
+        //Role of every logical volume (by instance ID) from its name,
+        //built at the beginning of each run
+        void BuildVolumeRoles();
     
     private:
         ATLTileCalTBEventAction* fEventAction;
+        std::vector<ATLTileCalTBGeometry::VolumeRole> fVolumeRoles;
 
 };
 
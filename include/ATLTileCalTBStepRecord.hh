@@ -0,0 +1,128 @@
+//**************************************************
+// \file ATLTileCalTBStepRecord.hh
+// \brief: definition of ATLTileCalTBStepRecord
+//         classes
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Binary side file of the raw (pre-Birk) scintillator deposits.
+// The file is a header followed by events, each event is an
+// ATLTileCalTBStepRecordEvent followed by its nRecords
+// ATLTileCalTBStepRecord. The deposits are written by the
+// ATLTileCalTBStepRecorder (one file per thread) when building
+// with the ATLTileCalTB_StepRecord compiler definition and read
+// back by ATLTileCalTBReDigi to re-run the digitization chain.
+
+#ifndef ATLTileCalTBStepRecord_h
+#define ATLTileCalTBStepRecord_h 1
+
+//Includers from Geant4
+//
+#include "G4Types.hh"
+#include "G4String.hh"
+#include "G4ThreadLocalSingleton.hh"
+
+//Includers from C++
+//
+#include <cstdint>
+#include <fstream>
+#include <type_traits>
+#include <vector>
+
+//File header
+//
+struct ATLTileCalTBStepRecordHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+};
+
+//Event header, energies in MeV
+//
+struct ATLTileCalTBStepRecordEvent {
+    std::uint32_t eventID;
+    std::uint32_t nRecords;
+    G4double eLeak;
+    G4double eCal;
+    G4double eLate;
+    std::int32_t pdgID;
+    G4float eBeam;
+};
+
+//Raw deposit of a step in a scintillator, lengths in mm,
+//energies in MeV and density in internal Geant4 units.
+//The deposits of the fast simulation models (fastDeposit flag) have
+//the visible energy (after Birk's law) in edep, the deposited energy
+//is edep * weight as for the steps and the other fields are 0
+//
+struct ATLTileCalTBStepRecord {
+    std::uint16_t cellIndex;
+    std::uint16_t timeBin;
+    std::uint16_t profileRow;
+    std::uint16_t flags;
+    G4float yLocal;
+    G4float zLocal;
+    G4float edep;
+    G4float weight;
+    G4float stepLength;
+    G4float charge;
+    G4float density;
+};
+
+static_assert(std::is_trivially_copyable_v<ATLTileCalTBStepRecord>, "Step records are written as raw bytes");
+static_assert(sizeof(ATLTileCalTBStepRecord) == 36, "Step record layout changed, bump the file version");
+
+namespace ATLTileCalTBStepRecordFile {
+
+    constexpr char magic[8] = { 'A', 'T', 'L', 'T', 'B', 'S', 'T', 'P' };
+    constexpr std::uint32_t version = 3;
+
+    //Flags of the step records
+    constexpr std::uint16_t fastDeposit = 1;
+
+    //Check the header of a step record file
+    G4bool IsValidHeader( const ATLTileCalTBStepRecordHeader& header );
+
+}
+
+//Per-thread writer of the step record file
+//
+class ATLTileCalTBStepRecorder {
+
+    friend class G4ThreadLocalSingleton<ATLTileCalTBStepRecorder>;
+
+    public:
+        //Return pointer to class instance
+        static ATLTileCalTBStepRecorder* GetInstance() {
+            static G4ThreadLocalSingleton<ATLTileCalTBStepRecorder> instance{};
+            return instance.Instance();
+        }
+
+        //Run-wise methods
+        //
+        void OpenFile( const G4String& fileName );
+        void CloseFile();
+
+        //Event-wise methods
+        //
+        void AddStep( const ATLTileCalTBStepRecord& record ) { fRecords.push_back(record); }
+        void WriteEvent( std::uint32_t eventID, G4double eLeak, G4double eCal, G4double eLate, G4int pdgID, G4double eBeam );
+
+    private:
+        //Private constructor
+        ATLTileCalTBStepRecorder() = default;
+
+        std::ofstream fFile;
+        std::vector<ATLTileCalTBStepRecord> fRecords;
+
+    public:
+        ATLTileCalTBStepRecorder(ATLTileCalTBStepRecorder const&) = delete;
+        void operator=(ATLTileCalTBStepRecorder const&) = delete;
+
+};
+
+#endif //ATLTileCalTBStepRecord_h
+
+//**************************************************
@@ -0,0 +1,76 @@
+//**************************************************
+// \file ATLTileCalTBTopoClustering.hh
+// \brief: definition of ATLTileCalTBTopoClustering
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Topological clustering of the cell signals of an event on the
+// cell neighbour graph of ATLTileCalTBGeometry::CellLUT:
+// clusters start from the seed cells (absolute signal above the
+// seed threshold, by decreasing significance) and grow through
+// the neighbouring cells above the grow threshold, two clusters
+// touching through such cells are merged, cells above the
+// terminal threshold only are added to the first cluster
+// reaching them and do not grow it further.
+// The thresholds are in units of the cell noise sigma and apply
+// to the absolute signal. Without noise they are not applied,
+// the clusters are the connected cells with a signal.
+// One instance per thread (it keeps its work buffers).
+
+#ifndef ATLTileCalTBTopoClustering_h
+#define ATLTileCalTBTopoClustering_h 1
+
+//Includers from Geant4
+//
+#include "G4Types.hh"
+
+//Includers from C++
+//
+#include <vector>
+
+class ATLTileCalTBTopoClustering {
+
+    public:
+        struct Cluster {
+            G4double energy;   //sum of the cell signals
+            G4int noOfCells;
+            G4int seed;        //cell index of the most significant seed
+        };
+
+        ATLTileCalTBTopoClustering();
+        ATLTileCalTBTopoClustering( G4double noiseSigma, G4double seedThreshold,
+                                    G4double growThreshold, G4double terminalThreshold );
+        ~ATLTileCalTBTopoClustering() = default;
+
+        //Apply the noise thresholds (default true), the cell signals
+        //have no noise otherwise
+        void SetNoise( G4bool noise ) { fNoise = noise; }
+
+        //Clusters of the cell signals (one per cell index),
+        //sorted by decreasing energy
+        const std::vector<Cluster>& Run( const std::vector<G4double>& signal );
+        const std::vector<Cluster>& GetClusters() const { return fClusters; }
+
+    private:
+        //Root of a (possibly merged) cluster label
+        std::size_t FindRoot( std::size_t label );
+
+        G4double fSeedCut;
+        G4double fGrowCut;
+        G4double fTerminalCut;
+        G4bool fNoise;
+
+        std::vector<std::size_t> fSeeds;
+        std::vector<std::size_t> fLabels;
+        std::vector<std::size_t> fParents;
+        std::vector<std::size_t> fQueue;
+        std::vector<Cluster> fClusters;
+
+};
+
+#endif //ATLTileCalTBTopoClustering_h
+
+//**************************************************
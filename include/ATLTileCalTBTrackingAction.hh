@@ -0,0 +1,45 @@
+//**************************************************
+// \file ATLTileCalTBTrackingAction.hh
+// \brief: definition of ATLTileCalTBTrackingAction
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+// Adds to ELate the kinetic energy of the neutrons killed in
+// flight by the neutron killer of the physics list, its time
+// limit is set to the time cut of the run by ATLTileCalTBRunAction.
+// With the fast simulation it also follows the descendants of the
+// sub-showers recorded for the shower library.
+
+#ifndef ATLTileCalTBTrackingAction_h
+#define ATLTileCalTBTrackingAction_h 1
+
+//Includers from Geant4
+//
+#include "G4UserTrackingAction.hh"
+
+//Forward declaration from project
+//
+class ATLTileCalTBEventAction;
+
+class ATLTileCalTBTrackingAction : public G4UserTrackingAction {
+
+    public:
+        ATLTileCalTBTrackingAction( ATLTileCalTBEventAction* eventAction );
+        virtual ~ATLTileCalTBTrackingAction();
+
+        #ifdef ATLTileCalTB_FastSim
+        virtual void PreUserTrackingAction( const G4Track* aTrack );
+        #endif
+        virtual void PostUserTrackingAction( const G4Track* aTrack );
+
+    private:
+        ATLTileCalTBEventAction* fEventAction;
+
+};
+
+#endif //ATLTileCalTBTrackingAction_h
+
+//**************************************************
@@ -9,21 +9,20 @@
 // A portable Geant4-based particle spectrum analyzer
 // to be used within a Geant4 simulation without affecting it.
 // Instead of coding it in the simulation, create a singleton
-// and manage its usage with (#ifdef) compiler definition.
-
-#ifdef ATLTileCalTB_LEAKANALYSIS
+// and manage its usage at run time (/tiletb/output/leakage).
 
 #ifndef SpectrumAnalyzer_h
-#  define SpectrumAnalyzer_h
+#define SpectrumAnalyzer_h
 
 // Includers from Geant4
 //
-#  include "G4Step.hh"
-#  include "G4ThreadLocalSingleton.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4ThreadLocalSingleton.hh"
 
 // Includers from C++
 //
-#  include <functional>
+#include <functional>
 
 class SpectrumAnalyzer
 {
@@ -42,22 +41,26 @@ class SpectrumAnalyzer
     // Run-wise methods
     void CreateNtupleAndScorer(const G4String scName = "te");
     inline void ClearNtupleID() { ntupleID = 99; }
+    inline G4int GetNtupleID() const { return ntupleID; }
     // Event-wise methods
     inline void ClearEventFields()
     {
       neutronScore = 0.;
-      protonScore = 0., pionScore = 0., gammaScore = 0., electronScore = 0., othersScore = 0.;
+      protonScore = 0., pionScore = 0., gammaScore = 0., electronScore = 0., neutrinoScore = 0.,
+      othersScore = 0.;
     }
     void FillEventFields() const;
     // Step-wise methods
-    void Analyze(const G4Step* step);
+    inline void Analyze(const G4Step* step) { Analyze(step->GetTrack()); }
+    // Track-wise methods (tracks killed at creation as leaking)
+    void Analyze(const G4Track* track);
 
   private:
     // Members
     //
     // Run-wise members
     G4int ntupleID;
-    std::function<G4double(const G4Step* step)> scorer;
+    std::function<G4double(const G4Track* track)> scorer;
     G4String scorerName{};
     // Event-wise members
     G4double neutronScore;
@@ -65,18 +68,13 @@ class SpectrumAnalyzer
     G4double pionScore;
     G4double gammaScore;
     G4double electronScore;
+    G4double neutrinoScore;
     G4double othersScore;
 
     // Scoring quantities
-    inline static G4double GetMomentum(const G4Step* step)
-    {
-      return step->GetTrack()->GetMomentum().mag();
-    };
-    inline static G4double GetKE(const G4Step* step)
-    {
-      return step->GetTrack()->GetKineticEnergy();
-    };
-    inline static G4double GetTE(const G4Step* step) { return step->GetTrack()->GetTotalEnergy(); };
+    inline static G4double GetMomentum(const G4Track* track) { return track->GetMomentum().mag(); };
+    inline static G4double GetKE(const G4Track* track) { return track->GetKineticEnergy(); };
+    inline static G4double GetTE(const G4Track* track) { return track->GetTotalEnergy(); };
 
   private:
     // Private constructor
@@ -88,6 +86,5 @@ class SpectrumAnalyzer
 };
 
 #endif  // SpectrumAnalyzer_h
-#endif  // ATLTileCalTB_LEAKANALYSIS
 
 //**************************************************
@@ -50,12 +50,15 @@ def main(args: list[str] = None) -> None:
 
     for pulse_file in sorted(os.listdir(pulse_dir)):
         full_pulse_file = pulse_dir.joinpath(pulse_file)
+        sampling = 0.5  # bin width of the files written before the time binning presets
         with open(full_pulse_file, encoding='utf-8') as real_pulse_file:
             label = real_pulse_file.readline().rstrip()[2:]
+            header = real_pulse_file.readline().split()
+            if header[:2] == ['#', 'bin_time_ns']:
+                sampling = float(header[2])
         data = np.loadtxt(full_pulse_file)
 
         datapoints = len(data)
-        sampling = 0.5
         max_x = int(datapoints * sampling)
 
         plt.plot(np.linspace(0, max_x, num=datapoints), data, label=label)
@@ -14,6 +14,8 @@
 #include "ATLTileCalTBRunAction.hh"
 #include "ATLTileCalTBEventAction.hh"
 #include "ATLTileCalTBStepAction.hh"
+#include "ATLTileCalTBStackingAction.hh"
+#include "ATLTileCalTBTrackingAction.hh"
 
 //Constructor and de-constructor
 //
@@ -35,10 +37,22 @@ void ATLTileCalTBActInitialization::Build() const {
     auto PrimaryGenAction = new ATLTileCalTBPrimaryGenAction();
     auto EventAction = new ATLTileCalTBEventAction(PrimaryGenAction);
 
+    auto StackingAction = new ATLTileCalTBStackingAction(EventAction);
+
     SetUserAction( PrimaryGenAction );
-    SetUserAction( new ATLTileCalTBRunAction( EventAction ) );
     SetUserAction( EventAction );
-    SetUserAction( new ATLTileCalTBStepAction( EventAction ) );
+    SetUserAction( StackingAction );
+    SetUserAction( new ATLTileCalTBTrackingAction( EventAction ) );
+
+    //ELeak and Ecal are collected by sensitive detectors (see ATLTileCalTBDetConstruction),
+    //the stepping action is only used to cross-check them
+    #ifdef ATLTileCalTB_StepAction
+    auto StepAction = new ATLTileCalTBStepAction(EventAction);
+    SetUserAction( new ATLTileCalTBRunAction( EventAction, StackingAction, StepAction ) );
+    SetUserAction( StepAction );
+    #else
+    SetUserAction( new ATLTileCalTBRunAction( EventAction, StackingAction ) );
+    #endif
 
 }
 
@@ -0,0 +1,77 @@
+//**************************************************
+// \file ATLTileCalTBAuxSD.cc
+// \brief: implementation of ATLTileCalTBAuxSD
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBAuxSD.hh"
+#include "ATLTileCalTBEventAction.hh"
+#include "SpectrumAnalyzer.hh"
+#ifdef ATLTileCalTB_FastSim
+#include "ATLTileCalTBShowerLibrary.hh"
+#include "ATLTileCalTBEmShower.hh"
+#endif
+
+//Includers from Geant4
+//
+#include "G4EventManager.hh"
+#include "G4Step.hh"
+
+//Constructor and de-constructor
+//
+ATLTileCalTBAuxSD::ATLTileCalTBAuxSD( const G4String& name, Quantity quantity )
+    : G4VSensitiveDetector(name),
+      fQuantity(quantity),
+      fEventAction(nullptr) {
+}
+
+ATLTileCalTBAuxSD::~ATLTileCalTBAuxSD() {}
+
+//Initialize base method
+//
+void ATLTileCalTBAuxSD::Initialize(G4HCofThisEvent*) {
+
+    //Event action of this thread (not known when the detector is constructed)
+    //
+    fEventAction = static_cast<ATLTileCalTBEventAction*>( G4EventManager::GetEventManager()->GetUserEventAction() );
+
+}
+
+//ProcessHits base method
+//
+G4bool ATLTileCalTBAuxSD::ProcessHits( G4Step* aStep, G4TouchableHistory* ) {
+
+    if ( fQuantity == Quantity::LEAKAGE ) {
+        //Collect out of world leakage
+        //
+        if ( aStep->GetPostStepPoint()->GetStepStatus() != fWorldBoundary ) return false;
+        fEventAction->Add( 0, aStep->GetTrack()->GetKineticEnergy() * aStep->GetTrack()->GetWeight() );
+        if ( auto spectrumAnalyzer = fEventAction->GetSpectrumAnalyzer() ) spectrumAnalyzer->Analyze(aStep);
+        #ifdef ATLTileCalTB_FastSim
+        auto showerRecorder = ATLTileCalTBShowerRecorder::GetInstance();
+        if ( showerRecorder->IsOpen() ) showerRecorder->AddLeak( aStep->GetTrack(), aStep->GetTrack()->GetKineticEnergy() * aStep->GetTrack()->GetWeight() );
+        #endif
+        return true;
+    }
+
+    //Collect calo energy deposition
+    //
+    const G4double edep = aStep->GetTotalEnergyDeposit();
+    if ( edep == 0. ) return false;
+    fEventAction->Add( 1, edep * aStep->GetTrack()->GetWeight() );
+    #ifdef ATLTileCalTB_FastSim
+    auto showerRecorder = ATLTileCalTBShowerRecorder::GetInstance();
+    if ( showerRecorder->IsOpen() ) showerRecorder->AddEcal( aStep->GetTrack(), edep * aStep->GetTrack()->GetWeight() );
+    auto emShowerTuner = ATLTileCalTBEmShowerTuner::GetInstance();
+    if ( emShowerTuner->IsActive() ) emShowerTuner->AddDeposit( aStep->GetPreStepPoint()->GetPosition(), aStep->GetPreStepPoint()->GetTouchable(), edep * aStep->GetTrack()->GetWeight() );
+    #endif
+    return true;
+
+}
+
+//**************************************************
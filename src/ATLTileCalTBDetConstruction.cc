@@ -11,24 +11,44 @@
 //
 #include "ATLTileCalTBDetConstruction.hh"
 #include "ATLTileCalTBSensDet.hh"
+#include "ATLTileCalTBAuxSD.hh"
+#include "ATLTileCalTBDetMessenger.hh"
+#include "ATLTileCalTBGeometry.hh"
+#ifdef ATLTileCalTB_FastSim
+#include "ATLTileCalTBShowerLibraryModel.hh"
+#include "ATLTileCalTBEmShowerModel.hh"
+#endif
 
 //Includers from Geant4
 //
 #include "G4LogicalVolume.hh"
 #include "G4GDMLParser.hh"
 #include "G4LogicalVolumeStore.hh"
+#include "G4PhysicalVolumeStore.hh"
 #include "G4VisAttributes.hh"
 #include "G4SDManager.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4UserLimits.hh"
+#include "G4Version.hh"
+#if G4VERSION_NUMBER >= 1110 // >= Geant4-11.1.0
+#include "G4EmParameters.hh"
+#endif
 
 //Constructors and de-constructor
 //
-ATLTileCalTBDetConstruction::ATLTileCalTBDetConstruction(const G4GDMLParser& parser) 
+ATLTileCalTBDetConstruction::ATLTileCalTBDetConstruction(const G4GDMLParser& parser, G4bool userLimits) 
     : G4VUserDetectorConstruction(),
-    fParser(parser)
+    fParser(parser),
+    fMessenger(new ATLTileCalTBDetMessenger(this)),
+    fUserLimits(userLimits),
+    fWoodcock(false)
 {}
 
 ATLTileCalTBDetConstruction::~ATLTileCalTBDetConstruction()
-{}
+{ delete fMessenger; }
 
 //Construct() method
 //
@@ -37,6 +57,7 @@ G4VPhysicalVolume* ATLTileCalTBDetConstruction::Construct() {
     auto worldPV = fParser.GetWorldVolume();
     
     DefineVisAttributes();
+    DefineRegions();
 
     return worldPV;
 
@@ -51,19 +72,196 @@ void ATLTileCalTBDetConstruction::ConstructSDandField() {
     auto caloSD = new ATLTileCalTBSensDet( "caloSD", "caloHitsCollection" );
     G4SDManager::GetSDMpointer()->AddNewDetector( caloSD );
 
+    //Ecal and ELeak scoring, unless collected by the stepping action
+    //
+    #ifndef ATLTileCalTB_StepAction
+    auto energySD = new ATLTileCalTBAuxSD( "energySD", ATLTileCalTBAuxSD::Quantity::ENERGY );
+    G4SDManager::GetSDMpointer()->AddNewDetector( energySD );
+    auto leakageSD = new ATLTileCalTBAuxSD( "leakageSD", ATLTileCalTBAuxSD::Quantity::LEAKAGE );
+    G4SDManager::GetSDMpointer()->AddNewDetector( leakageSD );
+    #endif
+
     //Assign to logical volumes
     //
     auto LVStore = G4LogicalVolumeStore::GetInstance();
     for(auto volume : *LVStore) {
 
         if( volume->GetName()=="Tile::Scintillator" ) volume->SetSensitiveDetector( caloSD );
+
+        #ifndef ATLTileCalTB_StepAction
+        const auto role = ATLTileCalTBGeometry::GetVolumeRole( volume->GetName() );
+        if( role==ATLTileCalTBGeometry::VolumeRole::ABSORBER || role==ATLTileCalTBGeometry::VolumeRole::PASSIVE ) volume->SetSensitiveDetector( energySD );
+        if( role==ATLTileCalTBGeometry::VolumeRole::WORLD ) volume->SetSensitiveDetector( leakageSD );
+        #endif
     
     }
 
+    //Register module volumes (depth 5 of the scintillator touchable)
+    //to build the touchable-to-cell lookup table once per thread
+    //
+    using ATLTileCalTBGeometry::Module;
+    auto PVStore = G4PhysicalVolumeStore::GetInstance();
+    for(auto volume : *PVStore) {
+
+        if( volume->GetName()=="Tile::BarrelModule" && volume->GetCopyNo()==1 ) caloSD->AddModuleVolume( volume, Module::LONG_LOWER );
+        if( volume->GetName()=="Tile::BarrelModule" && volume->GetCopyNo()==2 ) caloSD->AddModuleVolume( volume, Module::LONG_UPPER );
+        if( volume->GetName()=="EBarrelPos" )         caloSD->AddModuleVolume( volume, Module::EXTENDED );
+        if( volume->GetName()=="Tile::Plug2Module" )  caloSD->AddModuleVolume( volume, Module::EXTENDED_C10 );
+        //Tile::Plug1Module has no Tile::AbsorberChild
+        if( volume->GetName()=="Tile::ITCModule" )    caloSD->AddModuleVolume( volume, Module::EXTENDED_D4 );
+
+    }
+
+    //Parameterized shower model of the primary e+- and shower library model
+    //of the low-energy e+-/gamma in the periods, tried in this order
+    //(absorber region, the whole calorimeter with Woodcock tracking)
+    //
+    #ifdef ATLTileCalTB_FastSim
+    const auto modelRegionName = fWoodcock ? ATLTileCalTBGeometry::calo_region_name
+                                           : ATLTileCalTBGeometry::GetRegionName( ATLTileCalTBGeometry::VolumeRole::ABSORBER );
+    if( auto modelRegion = GetRegion( std::string(modelRegionName) ) ) {
+        new ATLTileCalTBEmShowerModel( "emShowerModel", modelRegion, caloSD );
+        new ATLTileCalTBShowerLibraryModel( "showerLibraryModel", modelRegion, caloSD );
+    }
+    #endif
+
     //No fields involved
 
 }
 
+//DefineRegions() method
+//
+void ATLTileCalTBDetConstruction::DefineRegions() {
+
+    //The volumes of a role are root volumes of its region (their daughters
+    //are in the same region unless they are root volumes of another one),
+    //with Woodcock tracking a single region holds the absorber and passive
+    //volumes as the photons are only tracked this way inside their region,
+    //the scintillator keeps its region so that the photons stop at its
+    //boundaries and interact at their exact points in the tiles
+    //
+    auto LVStore = G4LogicalVolumeStore::GetInstance();
+    if( fWoodcock ) {
+        auto region = new G4Region( std::string(ATLTileCalTBGeometry::calo_region_name) );
+        for(auto volume : *LVStore) {
+            if( volume->GetName()==std::string(ATLTileCalTBGeometry::calo_region_volume) ) region->AddRootLogicalVolume( volume );
+        }
+    }
+
+    for(auto volume : *LVStore) {
+
+        const auto role = ATLTileCalTBGeometry::GetVolumeRole( volume->GetName() );
+        if( fWoodcock && role!=ATLTileCalTBGeometry::VolumeRole::SCINTILLATOR ) continue;
+        const auto regionName = ATLTileCalTBGeometry::GetRegionName( role );
+        if( regionName.empty() ) continue;
+        auto region = G4RegionStore::GetInstance()->GetRegion( std::string(regionName), false );
+        if( !region ) region = new G4Region( std::string(regionName) );
+        region->AddRootLogicalVolume( volume );
+
+    }
+
+}
+
+//GetRegion() method
+//
+G4Region* ATLTileCalTBDetConstruction::GetRegion( const G4String& regionName ) const {
+
+    //With Woodcock tracking the Absorber and Passive regions are part of the CALO one
+    //
+    auto region = G4RegionStore::GetInstance()->GetRegion( regionName, false );
+    if( !region && fWoodcock && regionName!=std::string(ATLTileCalTBGeometry::calo_region_name) ) {
+        G4ExceptionDescription msg;
+        msg << "No region " << regionName << " with Woodcock tracking (/tiletb/region/woodcock), its volumes are in the "
+            << ATLTileCalTBGeometry::calo_region_name << " region";
+        G4Exception("ATLTileCalTBDetConstruction::GetRegion()", "MyCode0022", FatalErrorInArgument, msg);
+    }
+    if( !region ) {
+        G4ExceptionDescription msg;
+        msg << "No region " << regionName << " (is the geometry constructed?)";
+        G4Exception("ATLTileCalTBDetConstruction::GetRegion()", "MyCode0017", JustWarning, msg);
+    }
+    return region;
+
+}
+
+//SetRegionCut() method
+//
+void ATLTileCalTBDetConstruction::SetRegionCut( const G4String& regionName, const G4String& particle, G4double cut ) {
+
+    auto region = GetRegion( regionName );
+    if( !region ) return;
+
+    //Regions without cuts share the default cuts of the physics list, copy them first
+    //
+    auto defaultCuts = G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts();
+    auto cuts = region->GetProductionCuts();
+    if( !cuts || cuts==defaultCuts ) {
+        cuts = new G4ProductionCuts( *defaultCuts );
+        region->SetProductionCuts( cuts );
+    }
+    if( particle=="all" ) cuts->SetProductionCut( cut );
+    else cuts->SetProductionCut( cut, particle );
+
+}
+
+//SetRegionMinEkin() method
+//
+void ATLTileCalTBDetConstruction::SetRegionMinEkin( const G4String& regionName, G4double minEkin ) {
+
+    if( !fUserLimits ) {
+        G4ExceptionDescription msg;
+        msg << "User limits need G4StepLimiterPhysics (ATLTileCalTB -l 1), minEkin of " << regionName << " not applied";
+        G4Exception("ATLTileCalTBDetConstruction::SetRegionMinEkin()", "MyCode0021", JustWarning, msg);
+        return;
+    }
+    auto region = GetRegion( regionName );
+    if( !region ) return;
+    if( !region->GetUserLimits() ) region->SetUserLimits( new G4UserLimits() );
+    region->GetUserLimits()->SetUserMinEkine( minEkin );
+
+}
+
+//SetRegionMaxTime() method
+//
+void ATLTileCalTBDetConstruction::SetRegionMaxTime( const G4String& regionName, G4double maxTime ) {
+
+    if( !fUserLimits ) {
+        G4ExceptionDescription msg;
+        msg << "User limits need G4StepLimiterPhysics (ATLTileCalTB -l 1), maxTime of " << regionName << " not applied";
+        G4Exception("ATLTileCalTBDetConstruction::SetRegionMaxTime()", "MyCode0021", JustWarning, msg);
+        return;
+    }
+    auto region = GetRegion( regionName );
+    if( !region ) return;
+    if( !region->GetUserLimits() ) region->SetUserLimits( new G4UserLimits() );
+    region->GetUserLimits()->SetUserMaxTime( maxTime );
+
+}
+
+//SetWoodcock() method
+//
+void ATLTileCalTBDetConstruction::SetWoodcock( G4bool woodcock ) {
+
+    #if G4VERSION_NUMBER >= 1110
+    fWoodcock = woodcock;
+    auto emParameters = G4EmParameters::Instance();
+    if( woodcock ) {
+        emParameters->SetGeneralProcessActive( true );
+        emParameters->SetWoodcockActiveRegion( std::string(ATLTileCalTBGeometry::calo_region_name) );
+    }
+    else {
+        emParameters->SetWoodcockActiveRegion( "" );
+    }
+    #else
+    if( woodcock ) {
+        G4ExceptionDescription msg;
+        msg << "Woodcock tracking requires Geant4 11.1 or later, not enabled";
+        G4Exception("ATLTileCalTBDetConstruction::SetWoodcock()", "MyCode0018", JustWarning, msg);
+    }
+    #endif
+
+}
+
 //DefineVisAttributes() method
 //
 void ATLTileCalTBDetConstruction::DefineVisAttributes() {
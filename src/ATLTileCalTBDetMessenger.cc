@@ -0,0 +1,128 @@
+//**************************************************
+// \file ATLTileCalTBDetMessenger.cc
+// \brief: implementation of ATLTileCalTBDetMessenger
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBDetMessenger.hh"
+#include "ATLTileCalTBDetConstruction.hh"
+#include "ATLTileCalTBGeometry.hh"
+
+//Includers from Geant4
+//
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+
+//Includers from C++
+//
+#include <sstream>
+
+//Constructor and de-constructor
+//
+ATLTileCalTBDetMessenger::ATLTileCalTBDetMessenger( ATLTileCalTBDetConstruction* detConstruction )
+    : G4UImessenger(),
+      fDetConstruction(detConstruction) {
+
+    fRegionDir = new G4UIdirectory("/tiletb/region/", false);
+    fRegionDir->SetGuidance("Production cuts and user limits of the calorimeter regions");
+
+    G4String regionCandidates;
+    for ( const auto& region : ATLTileCalTBGeometry::region_names ) {
+        if ( !regionCandidates.empty() ) regionCandidates += " ";
+        regionCandidates += std::string(region.second);
+    }
+    regionCandidates += " " + std::string(ATLTileCalTBGeometry::calo_region_name);
+    const G4String energyUnits = G4UIcommand::UnitsList(G4UIcommand::CategoryOf("MeV").c_str());
+    const G4String lengthUnits = G4UIcommand::UnitsList(G4UIcommand::CategoryOf("mm").c_str());
+    const G4String timeUnits = G4UIcommand::UnitsList(G4UIcommand::CategoryOf("ns").c_str());
+
+    //Region, value and unit parameters of a command
+    //
+    auto setParameters = [&regionCandidates]( G4UIcommand* command, const char* value, const char* defaultUnit,
+                                              const G4String& units ) {
+        auto region = new G4UIparameter("region", 's', false);
+        region->SetParameterCandidates(regionCandidates.c_str());
+        command->SetParameter(region);
+        auto parameter = new G4UIparameter(value, 'd', false);
+        parameter->SetParameterRange((G4String(value) + ">=0.").c_str());
+        command->SetParameter(parameter);
+        auto unit = new G4UIparameter("unit", 's', true);
+        unit->SetDefaultValue(defaultUnit);
+        unit->SetParameterCandidates(units.c_str());
+        command->SetParameter(unit);
+        command->AvailableForStates(G4State_Idle);
+        command->SetToBeBroadcasted(false);
+    };
+
+    fCutCmd = new G4UIcommand("/tiletb/region/cut", this);
+    fCutCmd->SetGuidance("Production cut of a region for a particle (all of them by default), it is copied");
+    fCutCmd->SetGuidance("from the default cuts of the physics list the first time (default /run/setCut)");
+    setParameters(fCutCmd, "cut", "mm", lengthUnits);
+    auto cutParticle = new G4UIparameter("particle", 's', true);
+    cutParticle->SetDefaultValue("all");
+    cutParticle->SetParameterCandidates("all gamma e- e+ proton");
+    fCutCmd->SetParameter(cutParticle);
+
+    fMinEkinCmd = new G4UIcommand("/tiletb/region/minEkin", this);
+    fMinEkinCmd->SetGuidance("Kill the tracks below this kinetic energy in a region, their energy is deposited");
+    fMinEkinCmd->SetGuidance("where they stop (default 0)");
+    setParameters(fMinEkinCmd, "minEkin", "MeV", energyUnits);
+
+    fMaxTimeCmd = new G4UIcommand("/tiletb/region/maxTime", this);
+    fMaxTimeCmd->SetGuidance("Kill the tracks after this global time in a region, their energy is deposited");
+    fMaxTimeCmd->SetGuidance("where they stop (default none, see also /tiletb/tracking/timeCut)");
+    setParameters(fMaxTimeCmd, "maxTime", "ns", timeUnits);
+
+    fWoodcockCmd = new G4UIcmdWithABool("/tiletb/region/woodcock", this);
+    fWoodcockCmd->SetGuidance("Track the photons with the gamma general process and Woodcock tracking in a single");
+    fWoodcockCmd->SetGuidance("CALO region (replacing the Absorber and Passive regions, the Scintillator region is");
+    fWoodcockCmd->SetGuidance("kept out of it), before /run/initialize (Geant4 11.1 or later, default false)");
+    fWoodcockCmd->SetParameterName("woodcock", true);
+    fWoodcockCmd->SetDefaultValue(true);
+    fWoodcockCmd->AvailableForStates(G4State_PreInit);
+    fWoodcockCmd->SetToBeBroadcasted(false);
+
+}
+
+ATLTileCalTBDetMessenger::~ATLTileCalTBDetMessenger() {
+    delete fWoodcockCmd;
+    delete fMaxTimeCmd;
+    delete fMinEkinCmd;
+    delete fCutCmd;
+    delete fRegionDir;
+}
+
+//SetNewValue method
+//
+void ATLTileCalTBDetMessenger::SetNewValue( G4UIcommand* command, G4String newValue ) {
+    if ( command == fWoodcockCmd ) {
+        fDetConstruction->SetWoodcock(G4UIcmdWithABool::GetNewBoolValue(newValue));
+        return;
+    }
+
+    G4String region, unit, particle;
+    G4double value = 0.;
+    std::istringstream is(newValue);
+    is >> region >> value >> unit >> particle;
+    value *= G4UIcommand::ValueOf(unit.c_str());
+
+    if ( command == fCutCmd ) fDetConstruction->SetRegionCut(region, particle, value);
+    else if ( command == fMinEkinCmd ) fDetConstruction->SetRegionMinEkin(region, value);
+    else if ( command == fMaxTimeCmd ) fDetConstruction->SetRegionMaxTime(region, value);
+}
+
+//GetCurrentValue method
+//
+G4String ATLTileCalTBDetMessenger::GetCurrentValue( G4UIcommand* command ) {
+    if ( command == fWoodcockCmd ) return G4UIcommand::ConvertToString(fDetConstruction->GetWoodcock());
+    return "";
+}
+
+//**************************************************
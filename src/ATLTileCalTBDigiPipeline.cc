@@ -0,0 +1,253 @@
+//**************************************************
+// \file ATLTileCalTBDigiPipeline.cc
+// \brief: implementation of ATLTileCalTBDigiPipeline
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBDigiPipeline.hh"
+#include "ATLTileCalTBDigitization.hh"
+#include "ATLTileCalTBGeometry.hh"
+#include "ATLTileCalTBRandomBuffer.hh"
+
+//Includers from Geant4
+//
+#include "G4SystemOfUnits.hh"
+#include "CLHEP/Random/MixMaxRng.h"
+
+//Includers from C++
+//
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+//AddCell method of Event
+//
+void ATLTileCalTBDigiPipeline::Event::AddCell( std::size_t cellIndex, const ATLTileCalTBConstants::signal_t* sdepUp,
+                                               const ATLTileCalTBConstants::signal_t* sdepDown,
+                                               std::size_t begin, std::size_t end ) {
+    cells.push_back(cellIndex);
+    beginBins.push_back(begin);
+    endBins.push_back(end);
+    offsets.push_back(signal.size());
+    signal.insert(signal.end(), sdepUp + begin, sdepUp + end);
+    signal.insert(signal.end(), sdepDown + begin, sdepDown + end);
+}
+
+//Constructor and de-constructor
+//
+ATLTileCalTBDigiPipeline::ATLTileCalTBDigiPipeline( std::size_t noOfThreads, G4long runSeed, const ATLTileCalTBDigitizer& digitizer,
+                                                    G4bool noise, const ATLTileCalTBOptimalFilter* optimalFilter,
+                                                    const std::vector<ATLTileCalTBDigitizer>& variantDigitizers,
+                                                    const std::vector<std::size_t>& variantWindowBins )
+    : fRunSeed(runSeed),
+      fDigitizer(digitizer),
+      fNoise(noise),
+      fOptimalFilter(optimalFilter ? std::make_unique<ATLTileCalTBOptimalFilter>(*optimalFilter) : nullptr),
+      fVariantDigitizers(variantDigitizers),
+      fVariantWindowBins(variantWindowBins),
+      fBytesInFlight(0),
+      fNoOfCells(ATLTileCalTBGeometry::CellLUT::GetNumberOfCells()),
+      fStop(false) {
+    for ( std::size_t n = 0; n < noOfThreads; ++n ) fThreads.emplace_back(&ATLTileCalTBDigiPipeline::Run, this);
+}
+
+ATLTileCalTBDigiPipeline::~ATLTileCalTBDigiPipeline() {
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fStop = true;
+    }
+    fQueueCondition.notify_all();
+    for ( auto& thread : fThreads ) thread.join();
+}
+
+//Acquire method
+//
+ATLTileCalTBDigiPipeline::Event& ATLTileCalTBDigiPipeline::Acquire( const FlushFunction& flush ) {
+    std::unique_lock<std::mutex> lock(fMutex);
+
+    //Back-pressure: wait for the oldest events
+    while ( ( fFreeEvents.empty() && fEvents.size() >= fMaxEvents ) || fBytesInFlight >= fMaxBytes ) {
+        if ( !FlushFront(lock, true, flush) ) break;
+    }
+
+    Event* event = nullptr;
+    if ( fFreeEvents.empty() ) {
+        fEvents.push_back(std::make_unique<Event>());
+        event = fEvents.back().get();
+        event->edep.resize(fNoOfCells);
+        event->sdep.resize(fNoOfCells);
+        event->variantSdep.assign(fVariantDigitizers.size(), std::vector<G4double>(fNoOfCells));
+        if ( fOptimalFilter ) {
+            event->samples.resize(fNoOfCells * 2 * ATLTileCalTBConstants::readout_samples);
+            event->ofAmplitude.resize(fNoOfCells);
+            event->ofTime.resize(fNoOfCells);
+        }
+    }
+    else {
+        event = fFreeEvents.back();
+        fFreeEvents.pop_back();
+    }
+    event->cells.clear();
+    event->beginBins.clear();
+    event->endBins.clear();
+    event->offsets.clear();
+    event->signal.clear();
+    event->done = false;
+    return *event;
+}
+
+//Submit method
+//
+void ATLTileCalTBDigiPipeline::Submit( Event& event ) {
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fBytesInFlight += GetBytes(event);
+        fInFlight.push_back(&event);
+        fQueue.push_back(&event);
+    }
+    fQueueCondition.notify_one();
+}
+
+//Flush method
+//
+void ATLTileCalTBDigiPipeline::Flush( const FlushFunction& flush ) {
+    std::unique_lock<std::mutex> lock(fMutex);
+    while ( FlushFront(lock, false, flush) ) {}
+}
+
+//Finish method
+//
+void ATLTileCalTBDigiPipeline::Finish( const FlushFunction& flush ) {
+    std::unique_lock<std::mutex> lock(fMutex);
+    while ( FlushFront(lock, true, flush) ) {}
+}
+
+//FlushFront method
+//
+G4bool ATLTileCalTBDigiPipeline::FlushFront( std::unique_lock<std::mutex>& lock, G4bool wait, const FlushFunction& flush ) {
+    if ( fInFlight.empty() ) return false;
+    if ( wait ) fDoneCondition.wait(lock, [this]() { return fInFlight.front()->done; });
+    else if ( !fInFlight.front()->done ) return false;
+
+    Event* event = fInFlight.front();
+    fInFlight.pop_front();
+    lock.unlock();
+    flush(*event);
+    lock.lock();
+    fBytesInFlight -= GetBytes(*event);
+    fFreeEvents.push_back(event);
+    return true;
+}
+
+//GetSeed method
+//SplitMix64 finalizer of the combined inputs, 31 bits kept
+//
+G4long ATLTileCalTBDigiPipeline::GetSeed( G4long seed, G4long index ) {
+    std::uint64_t z = static_cast<std::uint64_t>(seed) * 0x9e3779b97f4a7c15ULL + static_cast<std::uint64_t>(index);
+    z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+    z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+    z ^= z >> 31;
+    return static_cast<G4long>(z >> 33);
+}
+
+//GetBytes method
+//
+std::size_t ATLTileCalTBDigiPipeline::GetBytes( const Event& event ) {
+    return event.signal.size() * sizeof(ATLTileCalTBConstants::signal_t);
+}
+
+//Run method
+//
+void ATLTileCalTBDigiPipeline::Run() {
+
+    //Engine, random buffer and digitizers of this thread (the
+    //thread is not a Geant4 thread, G4Random is not used)
+    CLHEP::MixMaxRng engine;
+    ATLTileCalTBRandomBuffer random(&engine);
+    ATLTileCalTBDigitizer digitizer(fDigitizer);
+    std::vector<ATLTileCalTBDigitizer> variantDigitizers(fVariantDigitizers);
+
+    //The digitizers need the signal at its time bins, the touched
+    //cells are copied in and cleared after use
+    const std::size_t frames = digitizer.GetFrames();
+    std::vector<ATLTileCalTBConstants::signal_t> sdepUp(frames, 0.);
+    std::vector<ATLTileCalTBConstants::signal_t> sdepDown(frames, 0.);
+    constexpr std::size_t noSlot = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> cellSlots(fNoOfCells, noSlot);
+
+    std::unique_lock<std::mutex> lock(fMutex);
+    while ( true ) {
+        fQueueCondition.wait(lock, [this]() { return fStop || !fQueue.empty(); });
+        if ( fQueue.empty() ) break;
+        Event& event = *fQueue.front();
+        fQueue.pop_front();
+        lock.unlock();
+
+        engine.setSeed(GetSeed(fRunSeed, event.eventID));
+        random.Reset();
+        for ( std::size_t i = 0; i < event.cells.size(); ++i ) cellSlots[event.cells[i]] = i;
+
+        //Same chain as in ATLTileCalTBEventAction::EndOfEventAction(): nominal
+        //digitization, variants and sampled readout, one pass over the cells each
+        const std::size_t noOfPasses = 1 + variantDigitizers.size() + ( fOptimalFilter ? 1 : 0 );
+        for ( std::size_t pass = 0; pass < noOfPasses; ++pass ) {
+            const G4bool nominal = ( pass == 0 );
+            const G4bool sampledReadout = ( pass == 1 + variantDigitizers.size() );
+            for ( std::size_t n = 0; n < fNoOfCells; ++n ) {
+                const std::size_t slot = cellSlots[n];
+                std::size_t begin = 0;
+                std::size_t end = 0;
+                if ( slot != noSlot ) {
+                    begin = event.beginBins[slot];
+                    end = event.endBins[slot];
+                    const auto first = event.signal.begin() + event.offsets[slot];
+                    std::copy(first, first + (end - begin), sdepUp.begin() + begin);
+                    std::copy(first + (end - begin), first + 2 * (end - begin), sdepDown.begin() + begin);
+                }
+
+                if ( nominal ) {
+                    if ( begin == end ) {
+                        event.sdep[n] = fNoise ? ATLTileCalTBDigitization::GetNoiseSignal(random) : 0.;
+                    }
+                    else {
+                        const G4double peakUp = digitizer.GetPeak(sdepUp.data(), begin, end);
+                        const G4double peakDown = digitizer.GetPeak(sdepDown.data(), begin, end);
+                        event.sdep[n] = fNoise ? ATLTileCalTBDigitization::GetCellSignal(peakUp, peakDown, random)
+                                               : peakUp + peakDown;
+                    }
+                }
+                else if ( sampledReadout ) {
+                    constexpr std::size_t cellSamples = 2 * ATLTileCalTBConstants::readout_samples;
+                    const G4double noiseSigma = fNoise ? ATLTileCalTBConstants::signal_noise_sigma : 0.;
+                    const auto result = fOptimalFilter->ReadoutCell(digitizer, sdepUp.data(), sdepDown.data(), begin, end,
+                                                                    noiseSigma, random, event.samples.data() + n * cellSamples);
+                    event.ofAmplitude[n] = result.amplitude;
+                    event.ofTime[n] = result.time / ns;
+                }
+                else {
+                    const auto& variant = ATLTileCalTBConstants::digi_variants[pass - 1];
+                    event.variantSdep[pass - 1][n] = variantDigitizers[pass - 1].GetCellSignal(
+                        sdepUp.data(), sdepDown.data(), begin, std::min(end, fVariantWindowBins[pass - 1]),
+                        variant.noise_sigma, variant.cut_multiple, random);
+                }
+
+                std::fill(sdepUp.begin() + begin, sdepUp.begin() + end, 0.);
+                std::fill(sdepDown.begin() + begin, sdepDown.begin() + end, 0.);
+            }
+        }
+
+        for ( auto cell : event.cells ) cellSlots[cell] = noSlot;
+
+        lock.lock();
+        event.done = true;
+        fDoneCondition.notify_all();
+    }
+
+}
+
+//**************************************************
@@ -0,0 +1,373 @@
+//**************************************************
+// \file ATLTileCalTBDigitizer.cc
+// \brief: implementation of ATLTileCalTBDigitizer
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBDigitizer.hh"
+
+//Includers from Geant4
+//
+#include "G4PhysicalConstants.hh"
+#include "G4Exception.hh"
+
+//Includers from C++
+//
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+    //Cost in multiply-adds of one FFT of size n
+    constexpr G4double FFTCost( std::size_t n ) {
+        std::size_t log2n = 0;
+        while ( (std::size_t(1) << log2n) < n ) log2n++;
+        //a butterfly is a complex multiplication and two complex additions
+        return static_cast<G4double>(n / 2 * log2n) * 5.;
+    }
+
+}
+
+//Constructors
+//
+ATLTileCalTBDigitizer::ATLTileCalTBDigitizer()
+    : ATLTileCalTBDigitizer(std::vector<G4double>(ATLTileCalTBConstants::pmt_response.begin(),
+                                                  ATLTileCalTBConstants::pmt_response.end())) {
+}
+
+ATLTileCalTBDigitizer::ATLTileCalTBDigitizer( const std::vector<G4double>& kernel, std::size_t frames )
+    : fKernel(kernel),
+      fFrames(frames),
+      fKernelSize(kernel.size()),
+      fFFTSize(GetFFTSize(kernel.size())),
+      fBlockSize(fFFTSize - fKernelSize + 1),
+      fMethod(Method::AUTO),
+      fKernelPeak(0),
+      fKernelPrefixMax(fKernelSize, 0.),
+      fKernelSuffixMax(fKernelSize, 0.),
+      fKernelFFT(fFFTSize),
+      fTwiddles(fFFTSize / 2),
+      fBitReverse(fFFTSize, 0),
+      fFFTBuffer(fFFTSize),
+      fBins(),
+      fValues() {
+
+    if ( fKernel.empty() || fFrames == 0 || fFrames > ATLTileCalTBConstants::frames ) {
+        G4ExceptionDescription msg;
+        msg << "Digitizer with " << fKernel.size() << " PMT response values and " << fFrames
+            << " frames, allowed are 1 to " << ATLTileCalTBConstants::frames << " frames";
+        G4Exception("ATLTileCalTBDigitizer::ATLTileCalTBDigitizer()", "MyCode0010", FatalException, msg);
+        return;
+    }
+
+    //Running maxima of the kernel, used to bound the pulse
+    //
+    fKernelPeak = std::max_element(fKernel.begin(), fKernel.end()) - fKernel.begin();
+    fKernelPrefixMax[0] = fKernel[0];
+    for ( std::size_t j = 1; j < fKernelSize; ++j ) fKernelPrefixMax[j] = std::max(fKernelPrefixMax[j - 1], fKernel[j]);
+    fKernelSuffixMax[fKernelSize - 1] = fKernel[fKernelSize - 1];
+    for ( std::size_t j = fKernelSize - 1; j-- > 0; ) fKernelSuffixMax[j] = std::max(fKernelSuffixMax[j + 1], fKernel[j]);
+
+    //Twiddle factors and bit reversal permutation
+    //
+    for ( std::size_t k = 0; k < fTwiddles.size(); ++k ) {
+        fTwiddles[k] = std::polar(1., -CLHEP::twopi * static_cast<G4double>(k) / fFFTSize);
+    }
+    std::size_t log2n = 0;
+    while ( (std::size_t(1) << log2n) < fFFTSize ) log2n++;
+    for ( std::size_t i = 0; i < fFFTSize; ++i ) {
+        for ( std::size_t bit = 0; bit < log2n; ++bit ) {
+            if ( i & (std::size_t(1) << bit) ) fBitReverse[i] |= std::size_t(1) << (log2n - 1 - bit);
+        }
+    }
+
+    //FFT of the zero padded kernel
+    //
+    std::fill(fKernelFFT.begin(), fKernelFFT.end(), 0.);
+    std::copy(fKernel.begin(), fKernel.end(), fKernelFFT.begin());
+    FFT(fKernelFFT, false);
+
+    fBins.reserve(fFrames);
+    fValues.reserve(fFrames);
+
+}
+
+//GetFFTSize method
+//Power of 2 with input blocks at least as long as the kernel
+//
+std::size_t ATLTileCalTBDigitizer::GetFFTSize( std::size_t kernelSize ) {
+    std::size_t size = 2;
+    while ( size < 2 * kernelSize ) size <<= 1;
+    return size;
+}
+
+//ConvolutePMT method
+//
+void ATLTileCalTBDigitizer::ConvolutePMT( const ATLTileCalTBConstants::signal_t* sdep, std::size_t begin, std::size_t end,
+                                          ATLTileCalTBDigitization::Pulse& pulse ) {
+
+    GatherBins(sdep, begin, end);
+    if ( fBins.empty() ) {
+        pulse.fill(0.);
+        return;
+    }
+    begin = fBins.front();
+    end = fBins.back() + 1;
+
+    G4double cost = 0.;
+    switch ( SelectMethod(begin, end, cost) ) {
+        case Method::AUTO:
+        case Method::SPARSE:
+            ConvoluteSparse(pulse);
+            break;
+        case Method::DIRECT:
+            ConvoluteDirect(sdep, begin, end, pulse);
+            break;
+        case Method::FFT:
+            ConvoluteFFT(sdep, begin, end, pulse);
+            break;
+    }
+
+}
+
+//GetPeak method
+//
+G4double ATLTileCalTBDigitizer::GetPeak( const ATLTileCalTBConstants::signal_t* sdep, std::size_t begin, std::size_t end ) {
+
+    GatherBins(sdep, begin, end);
+    if ( fBins.empty() ) return 0.;
+    begin = fBins.front();
+    end = fBins.back() + 1;
+
+    //The maximum is most likely between the kernel peaks of the first and last bins
+    //
+    const std::size_t lo = std::min(begin + fKernelPeak, fFrames - 1);
+    const std::size_t hi = std::min(end - 1 + fKernelPeak, fFrames - 1);
+
+    //Compute the full pulse if it is cheaper than the single samples
+    //
+    G4double fullCost = 0.;
+    const auto method = SelectMethod(begin, end, fullCost);
+    if ( static_cast<G4double>((hi - lo + 1) * fBins.size()) >= fullCost ) {
+        ATLTileCalTBDigitization::Pulse pulse;
+        switch ( method ) {
+            case Method::AUTO:
+            case Method::SPARSE:
+                ConvoluteSparse(pulse);
+                break;
+            case Method::DIRECT:
+                ConvoluteDirect(sdep, begin, end, pulse);
+                break;
+            case Method::FFT:
+                ConvoluteFFT(sdep, begin, end, pulse);
+                break;
+        }
+        return std::max(0., *(std::max_element(pulse.begin(), pulse.end())));
+    }
+
+    G4double peak = 0.;
+    for ( std::size_t k = lo; k <= hi; ++k ) peak = std::max(peak, EvaluateSample(k));
+
+    //Outside [lo, hi] every sample is bounded by the total signal times the
+    //running maximum of the kernel, stop as soon as the bound is below the peak
+    //
+    const G4double total = std::accumulate(fValues.begin(), fValues.end(), 0.);
+    for ( std::size_t k = hi + 1; k < fFrames && k - (end - 1) < fKernelSize; ++k ) {
+        if ( total * fKernelSuffixMax[k - (end - 1)] <= peak ) break;
+        peak = std::max(peak, EvaluateSample(k));
+    }
+    for ( std::size_t k = lo; k-- > begin; ) {
+        if ( total * fKernelPrefixMax[k - begin] <= peak ) break;
+        peak = std::max(peak, EvaluateSample(k));
+    }
+
+    return peak;
+
+}
+
+//GetSamples method
+//
+void ATLTileCalTBDigitizer::GetSamples( const ATLTileCalTBConstants::signal_t* sdep, std::size_t begin, std::size_t end,
+                                        const G4double* positions, std::size_t count, G4double* samples ) {
+    GatherBins(sdep, begin, end);
+    for ( std::size_t i = 0; i < count; ++i ) {
+        if ( fBins.empty() || positions[i] < 0. ) {
+            samples[i] = 0.;
+            continue;
+        }
+        const std::size_t k = static_cast<std::size_t>(positions[i]);
+        const G4double fraction = positions[i] - k;
+        const G4double low = ( k < fFrames ) ? EvaluateSample(k) : 0.;
+        const G4double high = ( fraction > 0. && k + 1 < fFrames ) ? EvaluateSample(k + 1) : 0.;
+        samples[i] = low + fraction * (high - low);
+    }
+}
+
+//GetCellSignal method
+//
+G4double ATLTileCalTBDigitizer::GetCellSignal( const ATLTileCalTBConstants::signal_t* sdepUp, const ATLTileCalTBConstants::signal_t* sdepDown,
+                                               std::size_t begin, std::size_t end, G4double noiseSigma, G4double cutMultiple,
+                                               ATLTileCalTBRandomBuffer& random ) {
+    if ( begin >= end ) return ATLTileCalTBDigitization::GetNoiseSignal(noiseSigma, cutMultiple, random);
+    return ATLTileCalTBDigitization::GetCellSignal(GetPeak(sdepUp, begin, end), GetPeak(sdepDown, begin, end),
+                                                   noiseSigma, cutMultiple, random);
+}
+
+//GatherBins method
+//
+void ATLTileCalTBDigitizer::GatherBins( const ATLTileCalTBConstants::signal_t* sdep, std::size_t begin, std::size_t end ) {
+    fBins.clear();
+    fValues.clear();
+    for ( std::size_t b = begin; b < end; ++b ) {
+        if ( sdep[b] != 0. ) {
+            fBins.push_back(b);
+            fValues.push_back(sdep[b]);
+        }
+    }
+}
+
+//SelectMethod method
+//
+ATLTileCalTBDigitizer::Method ATLTileCalTBDigitizer::SelectMethod( std::size_t begin, std::size_t end, G4double& cost ) const {
+
+    const G4double sparseCost = static_cast<G4double>(fBins.size() * fKernelSize);
+    const G4double directCost = static_cast<G4double>((end - begin) * fKernelSize);
+    //two input blocks per complex FFT (real and imaginary part)
+    const std::size_t nPairs = (end - begin + 2 * fBlockSize - 1) / (2 * fBlockSize);
+    const G4double fftCost = static_cast<G4double>(nPairs) * (2. * FFTCost(fFFTSize) + 4. * fFFTSize);
+
+    Method method = fMethod;
+    if ( method == Method::AUTO ) {
+        if ( fftCost < sparseCost ) method = Method::FFT;
+        //the direct loop has no indirection, prefer it for mostly filled ranges
+        else if ( 4 * fBins.size() < 3 * (end - begin) ) method = Method::SPARSE;
+        else method = Method::DIRECT;
+    }
+
+    switch ( method ) {
+        case Method::AUTO:
+        case Method::SPARSE:
+            cost = sparseCost;
+            break;
+        case Method::DIRECT:
+            cost = directCost;
+            break;
+        case Method::FFT:
+            cost = fftCost;
+            break;
+    }
+    return method;
+
+}
+
+//ConvoluteSparse method
+//The bins are added in decreasing order, so that every sample is summed
+//in the same order as in the textbook convolution
+//
+void ATLTileCalTBDigitizer::ConvoluteSparse( ATLTileCalTBDigitization::Pulse& pulse ) const {
+    const auto& kernel = fKernel;
+    pulse.fill(0.);
+    for ( std::size_t i = fBins.size(); i-- > 0; ) {
+        const std::size_t b = fBins[i];
+        const G4double value = fValues[i];
+        const std::size_t jmax = std::min(fKernelSize, fFrames - b);
+        G4double* out = pulse.data() + b;
+        for ( std::size_t j = 0; j < jmax; ++j ) out[j] += value * kernel[j];
+    }
+}
+
+//ConvoluteDirect method
+//Same as the convolution from https://gitlab.cern.ch/allpix-squared/allpix-squared/-/blob/86fe21ad37d353e36a509a0827562ab7fadd5104/src/modules/CSADigitizer/CSADigitizerModule.cpp#L271-L283
+//restricted to the filled range, with a contiguous inner loop
+//
+void ATLTileCalTBDigitizer::ConvoluteDirect( const ATLTileCalTBConstants::signal_t* sdep, std::size_t begin, std::size_t end,
+                                             ATLTileCalTBDigitization::Pulse& pulse ) const {
+    const auto& kernel = fKernel;
+    pulse.fill(0.);
+    for ( std::size_t b = end; b-- > begin; ) {
+        const G4double value = sdep[b];
+        const std::size_t jmax = std::min(fKernelSize, fFrames - b);
+        G4double* out = pulse.data() + b;
+        for ( std::size_t j = 0; j < jmax; ++j ) out[j] += value * kernel[j];
+    }
+}
+
+//ConvoluteFFT method
+//Overlap-add, two consecutive input blocks are packed in the real and
+//imaginary part of one FFT (the kernel is real)
+//
+void ATLTileCalTBDigitizer::ConvoluteFFT( const ATLTileCalTBConstants::signal_t* sdep, std::size_t begin, std::size_t end,
+                                          ATLTileCalTBDigitization::Pulse& pulse ) {
+    pulse.fill(0.);
+    for ( std::size_t start = begin; start < end; start += 2 * fBlockSize ) {
+        std::fill(fFFTBuffer.begin(), fFFTBuffer.end(), 0.);
+        for ( std::size_t n = 0; n < fBlockSize && start + n < end; ++n ) {
+            fFFTBuffer[n].real(sdep[start + n]);
+        }
+        for ( std::size_t n = 0; n < fBlockSize && start + fBlockSize + n < end; ++n ) {
+            fFFTBuffer[n].imag(sdep[start + fBlockSize + n]);
+        }
+
+        FFT(fFFTBuffer, false);
+        for ( std::size_t n = 0; n < fFFTSize; ++n ) fFFTBuffer[n] *= fKernelFFT[n];
+        FFT(fFFTBuffer, true);
+
+        for ( std::size_t n = 0; n < fFFTSize && start + n < fFrames; ++n ) {
+            pulse[start + n] += fFFTBuffer[n].real();
+        }
+        for ( std::size_t n = 0; n < fFFTSize && start + fBlockSize + n < fFrames; ++n ) {
+            pulse[start + fBlockSize + n] += fFFTBuffer[n].imag();
+        }
+    }
+}
+
+//EvaluateSample method
+//
+G4double ATLTileCalTBDigitizer::EvaluateSample( std::size_t k ) const {
+    const auto& kernel = fKernel;
+    G4double sample = 0.;
+    for ( std::size_t i = fBins.size(); i-- > 0; ) {
+        const std::size_t b = fBins[i];
+        if ( b > k ) continue;
+        if ( k - b >= fKernelSize ) break;
+        sample += fValues[i] * kernel[k - b];
+    }
+    return sample;
+}
+
+//FFT method
+//
+void ATLTileCalTBDigitizer::FFT( std::vector<std::complex<G4double>>& data, G4bool inverse ) const {
+
+    for ( std::size_t i = 0; i < fFFTSize; ++i ) {
+        if ( i < fBitReverse[i] ) std::swap(data[i], data[fBitReverse[i]]);
+    }
+
+    for ( std::size_t len = 2; len <= fFFTSize; len <<= 1 ) {
+        const std::size_t half = len / 2;
+        const std::size_t step = fFFTSize / len;
+        for ( std::size_t i = 0; i < fFFTSize; i += len ) {
+            for ( std::size_t j = 0; j < half; ++j ) {
+                const auto w = inverse ? std::conj(fTwiddles[j * step]) : fTwiddles[j * step];
+                const auto u = data[i + j];
+                const auto v = data[i + j + half] * w;
+                data[i + j] = u + v;
+                data[i + j + half] = u - v;
+            }
+        }
+    }
+
+    if ( inverse ) {
+        const G4double norm = 1. / static_cast<G4double>(fFFTSize);
+        for ( auto& value : data ) value *= norm;
+    }
+
+}
+
+//**************************************************
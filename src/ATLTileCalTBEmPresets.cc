@@ -0,0 +1,127 @@
+//**************************************************
+// \file ATLTileCalTBEmPresets.cc
+// \brief: implementation of ATLTileCalTBEmPresets
+//         namespace
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBEmPresets.hh"
+
+//Includers from Geant4
+//
+#include "G4EmParameters.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Version.hh"
+
+//Includers from C++
+//
+#include <algorithm>
+#include <array>
+
+namespace ATLTileCalTBEmPresets {
+
+    namespace {
+
+        struct EmPreset {
+            const char* name;
+            G4MscStepLimitType mscStepLimit;
+            G4double lowestElectronEnergy;
+            G4bool generalProcess;       // only enables it, some physics lists already do
+            G4bool urbanFluctuation;     // Urban model instead of the universal one (Geant4 11)
+        };
+
+        //"validation": more accurate msc steps near the boundaries of the thin layers and
+        //              electrons tracked down to 100 eV
+        //"fast":       minimal msc step limitation, electrons below 100 keV stopped (range
+        //              well below the 3 mm tiles) and gamma general process
+        constexpr std::array<EmPreset, 2> em_presets {{
+            {"validation", fUseSafetyPlus, 100. * eV,  false, true},
+            {"fast",       fMinimal,       100. * keV, true,  false},
+        }};
+
+        //Settings of the physics list changed by the presets, restored
+        //before applying a preset so that presets do not stack
+        struct PhysicsListSettings {
+            G4MscStepLimitType mscStepLimit;
+            G4double lowestElectronEnergy;
+            G4bool generalProcess;
+            #if G4VERSION_NUMBER >= 1100
+            G4EmFluctuationType fluctuation;
+            #endif
+        };
+
+        //Saved at the first call (the first Apply, after the physics list constructors)
+        const PhysicsListSettings& GetPhysicsListSettings() {
+            static const PhysicsListSettings settings = [] {
+                auto emParameters = G4EmParameters::Instance();
+                return PhysicsListSettings{ emParameters->MscStepLimitType(), emParameters->LowestElectronEnergy(),
+                                            emParameters->GeneralProcessActive()
+                                            #if G4VERSION_NUMBER >= 1100
+                                            , emParameters->FluctuationType()
+                                            #endif
+                                          };
+            }();
+            return settings;
+        }
+
+        G4String& ActivePreset() {
+            static G4String active = "default";
+            return active;
+        }
+
+    }
+
+    //GetNames method
+    //
+    std::vector<G4String> GetNames() {
+        std::vector<G4String> names{"default"};
+        for ( const auto& preset : em_presets ) names.push_back(preset.name);
+        return names;
+    }
+
+    //Apply method
+    //
+    G4bool Apply( const G4String& name ) {
+        auto preset = std::find_if(em_presets.begin(), em_presets.end(),
+                                   [&name](const EmPreset& p) { return name == p.name; });
+        if ( name != "default" && preset == em_presets.end() ) return false;
+
+        //Restore the physics list settings ("default"), the general
+        //process stays active with Woodcock tracking (/tiletb/region/woodcock)
+        //
+        auto emParameters = G4EmParameters::Instance();
+        const auto& physicsList = GetPhysicsListSettings();
+        emParameters->SetMscStepLimitType(physicsList.mscStepLimit);
+        emParameters->SetLowestElectronEnergy(physicsList.lowestElectronEnergy);
+        G4bool generalProcess = physicsList.generalProcess;
+        #if G4VERSION_NUMBER >= 1110
+        generalProcess = generalProcess || !emParameters->GetWoodcockActiveRegion().empty();
+        #endif
+        emParameters->SetGeneralProcessActive(generalProcess);
+        #if G4VERSION_NUMBER >= 1100
+        emParameters->SetFluctuationType(physicsList.fluctuation);
+        #endif
+
+        if ( preset != em_presets.end() ) {
+            emParameters->SetMscStepLimitType(preset->mscStepLimit);
+            emParameters->SetLowestElectronEnergy(preset->lowestElectronEnergy);
+            if ( preset->generalProcess ) emParameters->SetGeneralProcessActive(true);
+            #if G4VERSION_NUMBER >= 1100
+            emParameters->SetFluctuationType(preset->urbanFluctuation ? fUrbanFluctuation : fUniversalFluctuation);
+            #endif
+        }
+        ActivePreset() = name;
+        return true;
+    }
+
+    //GetActive method
+    //
+    const G4String& GetActive() { return ActivePreset(); }
+
+}
+
+//**************************************************
@@ -0,0 +1,207 @@
+//**************************************************
+// \file ATLTileCalTBEmShower.cc
+// \brief: implementation of ATLTileCalTBEmShower
+//         classes
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBEmShower.hh"
+
+//Includers from Geant4
+//
+#include "G4AutoLock.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4VTouchable.hh"
+#include "G4ios.hh"
+
+//Includers from C++
+//
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    G4Mutex runSumsMutex = G4MUTEX_INITIALIZER;
+
+    //Radial profile of the tuner, showers wider than this are in the last bin
+    constexpr std::size_t radialBins = 500;
+
+    //Sums of an empty run
+    constexpr G4double noX = std::numeric_limits<G4double>::max();
+}
+
+ATLTileCalTBEmShowerTuner::Sums ATLTileCalTBEmShowerTuner::fRunSums{ 0., 0., 0., noX, -noX, {}, {}, 0., 0., 0. };
+
+//Constructor of ATLTileCalTBEmShower
+//
+ATLTileCalTBEmShower::ATLTileCalTBEmShower()
+    : fEnabled(false),
+      fParameters(ATLTileCalTBConstants::em_shower_parameters) {
+}
+
+//GetProfile method
+//
+ATLTileCalTBEmShower::Profile ATLTileCalTBEmShower::GetProfile( G4double energy ) const {
+    const G4double x = std::log( energy / GeV );
+    return Profile{ std::max( fParameters.depth0 + fParameters.depth1 * x, 1. ) * mm,
+                    std::max( fParameters.shape0 + fParameters.shape1 * x, 1. ),
+                    std::max( fParameters.radius0 + fParameters.radius1 * x, 0.1 ) * mm };
+}
+
+//Add method of Sums
+//
+void ATLTileCalTBEmShowerTuner::Sums::Add( const Sums& other ) {
+    n += other.n;
+    x += other.x;
+    xx += other.xx;
+    xMin = std::min( xMin, other.xMin );
+    xMax = std::max( xMax, other.xMax );
+    for ( std::size_t k = 0; k < y.size(); ++k ) {
+        y[k] += other.y[k];
+        xy[k] += other.xy[k];
+    }
+    eCal += other.eCal;
+    ePeriods += other.ePeriods;
+    eScintillator += other.eScintillator;
+}
+
+//Constructor of ATLTileCalTBEmShowerTuner
+//
+ATLTileCalTBEmShowerTuner::ATLTileCalTBEmShowerTuner()
+    : fActive(false),
+      fPeriodLayouts(nullptr),
+      fSums{ 0., 0., 0., noX, -noX, {}, {}, 0., 0., 0. },
+      fPosition(),
+      fDirection(),
+      fEnergy(0.),
+      fECal(0.),
+      fEPeriods(0.),
+      fEScintillator(0.),
+      fDepthSum(0.),
+      fDepth2Sum(0.),
+      fRadialProfile(radialBins, 0.) {
+}
+
+//SetActive method
+//
+void ATLTileCalTBEmShowerTuner::SetActive( G4bool active ) {
+    fActive = active;
+    if ( active && !fPeriodLayouts ) fPeriodLayouts = std::make_unique<ATLTileCalTBPeriodLayouts>();
+}
+
+//SetStart method
+//
+void ATLTileCalTBEmShowerTuner::SetStart( const G4ThreeVector& position, const G4ThreeVector& direction, G4double energy ) {
+    if ( HasStart() ) return;
+    fPosition = position;
+    fDirection = direction.unit();
+    fEnergy = energy;
+}
+
+//AddDeposit method
+//
+void ATLTileCalTBEmShowerTuner::AddDeposit( const G4ThreeVector& position, const G4VTouchable* touchable, G4double edep ) {
+    if ( !HasStart() ) return;
+    //Same test as the spots of ATLTileCalTBEmShowerModel::AddSpot()
+    if ( fPeriodLayouts->FindPeriodDepth( touchable ) >= 0 ) fEPeriods += edep;
+    const auto distance = position - fPosition;
+    const G4double depth = distance.dot( fDirection );
+    const G4double radius = ( distance - depth * fDirection ).mag();
+    fECal += edep;
+    fDepthSum += depth * edep;
+    fDepth2Sum += depth * depth * edep;
+    fRadialProfile[std::min( static_cast<std::size_t>( radius / fRadialBin ), radialBins - 1 )] += edep;
+}
+
+//EndOfEvent method
+//
+void ATLTileCalTBEmShowerTuner::EndOfEvent() {
+
+    if ( HasStart() && fECal > 0. ) {
+        //Median radius (bin center)
+        G4double cumulative = 0.;
+        std::size_t medianBin = 0;
+        while ( medianBin + 1 < radialBins && ( cumulative += fRadialProfile[medianBin] ) < 0.5 * fECal ) ++medianBin;
+
+        const G4double x = std::log( fEnergy / GeV );
+        const std::array<G4double, 3> y{ fDepthSum / fECal / mm, fDepth2Sum / fECal / ( mm * mm ),
+                                         ( medianBin + 0.5 ) * fRadialBin / mm };
+        fSums.n += 1.;
+        fSums.x += x;
+        fSums.xx += x * x;
+        fSums.xMin = std::min( fSums.xMin, x );
+        fSums.xMax = std::max( fSums.xMax, x );
+        for ( std::size_t k = 0; k < y.size(); ++k ) {
+            fSums.y[k] += y[k];
+            fSums.xy[k] += x * y[k];
+        }
+        fSums.eCal += fECal;
+        fSums.ePeriods += fEPeriods;
+        fSums.eScintillator += fEScintillator;
+    }
+
+    fEnergy = 0.;
+    fECal = 0.;
+    fEPeriods = 0.;
+    fEScintillator = 0.;
+    fDepthSum = 0.;
+    fDepth2Sum = 0.;
+    std::fill( fRadialProfile.begin(), fRadialProfile.end(), 0. );
+
+}
+
+//Merge method
+//
+void ATLTileCalTBEmShowerTuner::Merge() {
+    G4AutoLock lock(&runSumsMutex);
+    fRunSums.Add( fSums );
+    fSums = Sums{ 0., 0., 0., noX, -noX, {}, {}, 0., 0., 0. };
+}
+
+//Report method
+//
+void ATLTileCalTBEmShowerTuner::Report() {
+
+    G4AutoLock lock(&runSumsMutex);
+    const Sums sums = fRunSums;
+    fRunSums = Sums{ 0., 0., 0., noX, -noX, {}, {}, 0., 0., 0. };
+    lock.unlock();
+
+    if ( sums.n < 1. || sums.ePeriods <= 0. ) {
+        G4cout << "EM shower tuning: no primary e+- shower in this run" << G4endl;
+        return;
+    }
+
+    //Linear fits (constant if a single energy)
+    //
+    const G4double denominator = sums.n * sums.xx - sums.x * sums.x;
+    std::array<G4double, 3> intercept{};
+    std::array<G4double, 3> slope{};
+    for ( std::size_t k = 0; k < intercept.size(); ++k ) {
+        slope[k] = ( std::abs(denominator) > 1.e-9 * sums.n * sums.n ) ? ( sums.n * sums.xy[k] - sums.x * sums.y[k] ) / denominator : 0.;
+        intercept[k] = ( sums.y[k] - slope[k] * sums.x ) / sums.n;
+    }
+
+    //Gamma shape of the mean profile at the lowest and highest energies
+    //
+    auto shapeAt = [&intercept, &slope]( G4double x ) {
+        const G4double mean = intercept[0] + slope[0] * x;
+        const G4double variance = intercept[1] + slope[1] * x - mean * mean;
+        return ( variance > 0. ) ? mean * mean / variance : 1.;
+    };
+    const G4double shapeMin = shapeAt( sums.xMin );
+    const G4double shapeMax = shapeAt( sums.xMax );
+    const G4double shape1 = ( sums.xMax > sums.xMin ) ? ( shapeMax - shapeMin ) / ( sums.xMax - sums.xMin ) : 0.;
+    const G4double shape0 = shapeMin - shape1 * sums.xMin;
+
+    G4cout << "EM shower tuning: " << sums.n << " primary e+- showers, parameters to apply with" << G4endl
+           << "/tiletb/emShower/parameters " << intercept[0] << " " << slope[0] << " " << shape0 << " " << shape1 << " "
+           << intercept[2] << " " << slope[2] << " " << sums.eScintillator / sums.ePeriods << G4endl;
+
+}
+
+//**************************************************
@@ -0,0 +1,167 @@
+//**************************************************
+// \file ATLTileCalTBEmShowerModel.cc
+// \brief: implementation of ATLTileCalTBEmShowerModel
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBEmShowerModel.hh"
+#include "ATLTileCalTBEmShower.hh"
+#include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBDigitization.hh"
+#include "ATLTileCalTBEventAction.hh"
+#include "ATLTileCalTBSensDet.hh"
+
+//Includers from Geant4
+//
+#include "G4EventManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4Material.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4Track.hh"
+#include "G4NavigationHistory.hh"
+#include "G4TransportationManager.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+
+//Includers from C++
+//
+#include <algorithm>
+#include <cmath>
+
+//Constructor and de-constructor
+//
+ATLTileCalTBEmShowerModel::ATLTileCalTBEmShowerModel( const G4String& name, G4Region* region, ATLTileCalTBSensDet* sensDet )
+    : G4VFastSimulationModel(name, region),
+      fSensDet(sensDet),
+      fPeriodLayouts(),
+      fVolumeRoles(),
+      fCaloVolume(nullptr),
+      fScintillatorDensity(0.),
+      fNavigator(),
+      fTouchable() {
+
+    for ( auto volume : *G4LogicalVolumeStore::GetInstance() ) {
+        const std::size_t id = volume->GetInstanceID();
+        if ( id >= fVolumeRoles.size() ) fVolumeRoles.resize( id + 1, ATLTileCalTBGeometry::VolumeRole::ENVELOPE );
+        fVolumeRoles[id] = ATLTileCalTBGeometry::GetVolumeRole( volume->GetName() );
+        if ( fVolumeRoles[id] == ATLTileCalTBGeometry::VolumeRole::SCINTILLATOR ) fScintillatorDensity = volume->GetMaterial()->GetDensity();
+        if ( volume->GetName() == std::string(ATLTileCalTBGeometry::calo_region_volume) ) fCaloVolume = volume;
+    }
+
+}
+
+ATLTileCalTBEmShowerModel::~ATLTileCalTBEmShowerModel() {}
+
+//IsApplicable method
+//
+G4bool ATLTileCalTBEmShowerModel::IsApplicable( const G4ParticleDefinition& particle ) {
+    return &particle == G4Electron::Definition() || &particle == G4Positron::Definition();
+}
+
+//ModelTrigger method
+//
+G4bool ATLTileCalTBEmShowerModel::ModelTrigger( const G4FastTrack& fastTrack ) {
+
+    auto tuner = ATLTileCalTBEmShowerTuner::GetInstance();
+    if ( !tuner->IsActive() && !ATLTileCalTBEmShower::GetInstance()->IsEnabled() ) return false;
+
+    //Primary e+- above the minimum energy starting a step in a period
+    //of a module with parsable periods
+    //
+    const auto track = fastTrack.GetPrimaryTrack();
+    if ( track->GetParentID() != 0 || track->GetKineticEnergy() < ATLTileCalTBConstants::em_shower_min_energy ) return false;
+    if ( !fPeriodLayouts.Find( track->GetVolume()->GetLogicalVolume() ) ) return false;
+    if ( fSensDet->GetNumberOfPeriods( track->GetTouchableHandle()->GetVolume(3) ) == 0 ) return false;
+
+    //Tuning mode: start point of the full-sim shower
+    //
+    if ( tuner->IsActive() ) {
+        tuner->SetStart( track->GetPosition(), track->GetMomentumDirection(), track->GetKineticEnergy() );
+        return false;
+    }
+    return true;
+
+}
+
+//DoIt method
+//
+void ATLTileCalTBEmShowerModel::DoIt( const G4FastTrack& fastTrack, G4FastStep& fastStep ) {
+
+    if ( !fNavigator.GetWorldVolume() ) {
+        fNavigator.SetWorldVolume( G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume() );
+    }
+
+    //Spots of equal energy: gamma distributed depth along the direction
+    //of the primary and GFlash radial profile around it
+    //
+    const auto track = fastTrack.GetPrimaryTrack();
+    const G4double energy = track->GetKineticEnergy();
+    const auto profile = ATLTileCalTBEmShower::GetInstance()->GetProfile( energy );
+    const G4ThreeVector direction = track->GetMomentumDirection();
+    const G4ThreeVector orthogonal = direction.orthogonal().unit();
+    const G4ThreeVector binormal = direction.cross( orthogonal );
+    const auto nSpots = static_cast<std::size_t>( std::ceil( energy / ATLTileCalTBConstants::em_shower_spot_energy ) );
+    const G4double spotEnergy = energy / nSpots * track->GetWeight();
+
+    for ( std::size_t n = 0; n < nSpots; ++n ) {
+        const G4double depth = CLHEP::RandGamma::shoot( profile.shape, profile.shape / profile.depth );
+        const G4double u = std::min( G4UniformRand(), 0.99 );
+        const G4double radius = profile.radius * std::sqrt( u / ( 1. - u ) );
+        const G4double phi = CLHEP::twopi * G4UniformRand();
+        const G4ThreeVector position = track->GetPosition() + depth * direction
+                                       + radius * ( std::cos(phi) * orthogonal + std::sin(phi) * binormal );
+        AddSpot( position, track->GetGlobalTime() + depth / c_light, spotEnergy );
+    }
+
+    fastStep.KillPrimaryTrack();
+    fastStep.ProposePrimaryTrackPathLength( 0. );
+    fastStep.ProposeTotalEnergyDeposited( 0. );
+
+}
+
+//AddSpot method
+//
+void ATLTileCalTBEmShowerModel::AddSpot( const G4ThreeVector& position, G4double time, G4double energy ) {
+
+    //Calo energy inside the calorimeter, the spots in its air envelopes and gaps
+    //stand for the shower energy around them, leakage outside
+    //
+    auto eventAction = static_cast<ATLTileCalTBEventAction*>( G4EventManager::GetEventManager()->GetUserEventAction() );
+    fNavigator.LocateGlobalPointAndUpdateTouchable( position, &fTouchable, false );
+    const auto volume = fTouchable.GetVolume();
+    const std::size_t id = volume ? volume->GetLogicalVolume()->GetInstanceID() : fVolumeRoles.size();
+    const G4bool calorimeter = id < fVolumeRoles.size() && ATLTileCalTBGeometry::IsCalorimeter( fVolumeRoles[id] );
+    G4bool insideCalo = calorimeter;
+    for ( G4int i = 0; volume && !insideCalo && i <= fTouchable.GetHistoryDepth(); ++i ) {
+        insideCalo = fTouchable.GetVolume(i)->GetLogicalVolume() == fCaloVolume;
+    }
+    eventAction->Add( insideCalo ? 1 : 0, energy );
+    if ( !calorimeter ) return;
+
+    //Scintillator signal of the spots in a period (module 3 levels above),
+    //in the closest tile row
+    //
+    const G4int d = fPeriodLayouts.FindPeriodDepth( &fTouchable );
+    if ( d < 0 ) return;
+    const auto layout = fPeriodLayouts.Find( fTouchable.GetVolume(d)->GetLogicalVolume() );
+    const auto local = fTouchable.GetHistory()->GetTransform( fTouchable.GetHistoryDepth() - d ).TransformPoint( position );
+    const auto& tile = layout->FindClosestTile( local.z() );
+    const G4double edep = energy * ATLTileCalTBEmShower::GetInstance()->GetParameters().sampling_fraction;
+    const G4double visibleEnergy = ATLTileCalTBDigitization::BirkLaw( edep, edep / ATLTileCalTBConstants::em_shower_spot_dedx,
+                                                                       -1., fScintillatorDensity );
+    fSensDet->AddFastDeposit( fTouchable.GetVolume(d + 3), tile.row, fTouchable.GetVolume(d)->GetCopyNo(), time,
+                              std::clamp( local.y(), -tile.yHalf, tile.yHalf ),
+                              std::clamp( local.z() - tile.z, -tile.zHalf, tile.zHalf ), edep, visibleEnergy );
+
+}
+
+//**************************************************
@@ -12,68 +12,173 @@
 #include "ATLTileCalTBEventAction.hh"
 #include "ATLTileCalTBGeometry.hh"
 #include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBDigitization.hh"
 #include "ATLTileCalTBPrimaryGenAction.hh"
-#ifdef ATLTileCalTB_LEAKANALYSIS
 #include "SpectrumAnalyzer.hh"
+#ifdef ATLTileCalTB_StepRecord
+#include "ATLTileCalTBStepRecord.hh"
+#endif
+#ifdef ATLTileCalTB_FastSim
+#include "ATLTileCalTBShowerLibrary.hh"
+#include "ATLTileCalTBEmShower.hh"
 #endif
 
 //Includers from Geant4
 //
 #include "G4Event.hh"
-#include "Randomize.hh"
 #include "G4ParticleGun.hh"
+#include "G4SystemOfUnits.hh"
 #include "G4Version.hh"
 #if G4VERSION_NUMBER < 1100
 #include "g4root.hh"  // replaced by G4AnalysisManager.h  in G4 v11 and up
 #else
 #include "G4AnalysisManager.hh"
 #endif
-#ifdef ATLTileCalTB_PulseOutput
 #include "G4RunManager.hh"
 #include "G4Run.hh"
-#endif
 
 //Includers from C++
 //
 #include <numeric>
 #include <algorithm>
-#ifdef ATLTileCalTB_PulseOutput
 #include <fstream>
 #include <sstream>
 #include <filesystem>
-#endif
+#include <limits>
 
 //Constructor and de-constructor
 //
 ATLTileCalTBEventAction::ATLTileCalTBEventAction(ATLTileCalTBPrimaryGenAction* pga)
     : G4UserEventAction(),
       fPrimaryGenAction(pga),
-      fNoOfCells(ATLTileCalTBGeometry::CellLUT::GetInstance()->GetNumberOfCells()),
-      fAux{0., 0.} {
-    fEdepVector = std::vector<G4double>(fNoOfCells, 0.);
-    fSdepVector = std::vector<G4double>(fNoOfCells, 0.);
+      fRandomBuffer(ATLTileCalTBRandomBuffer::GetInstance()),
+      fDigitizer(),
+      fNoOfCells(ATLTileCalTBGeometry::CellLUT::GetNumberOfCells()),
+      fAux{0., 0., 0.},
+      fNtuple(),
+      fDigitizeCell(&ATLTileCalTBEventAction::DigitizeCell<true, false>),
+      fBinTime(ATLTileCalTBConstants::frame_bin_time),
+      fTimeWindow(ATLTileCalTBConstants::frame_time_window),
+      fTimeCut(std::numeric_limits<G4double>::max()),
+      fFrames(ATLTileCalTBConstants::frames),
+      fSignalTimeProfile(),
+      fNoise(true),
+      fPulseOutput(false),
+      fSpectrumAnalyzer(nullptr),
+      fPipeline(nullptr) {
 }
 
 ATLTileCalTBEventAction::~ATLTileCalTBEventAction() {
 }
 
+//SetRunModes method
+//
+void ATLTileCalTBEventAction::SetRunModes( G4bool noise, G4bool pulseOutput, G4bool leakAnalysis ) {
+    if ( noise ) {
+        fDigitizeCell = pulseOutput ? &ATLTileCalTBEventAction::DigitizeCell<true, true>
+                                    : &ATLTileCalTBEventAction::DigitizeCell<true, false>;
+    }
+    else {
+        fDigitizeCell = pulseOutput ? &ATLTileCalTBEventAction::DigitizeCell<false, true>
+                                    : &ATLTileCalTBEventAction::DigitizeCell<false, false>;
+    }
+    fNoise = noise;
+    fPulseOutput = pulseOutput;
+    fSpectrumAnalyzer = leakAnalysis ? SpectrumAnalyzer::GetInstance() : nullptr;
+}
+
+//SetLayout method
+//
+void ATLTileCalTBEventAction::SetLayout( G4double binTime, G4double timeWindow ) {
+    fBinTime = binTime;
+    fTimeWindow = timeWindow;
+    fFrames = static_cast<std::size_t>(timeWindow / binTime);
+
+    fDigitizer = ATLTileCalTBDigitizer(ATLTileCalTBDigitization::GetPMTResponse(1., fBinTime), fFrames);
+    fNtuple.SetLayout(fBinTime, fFrames);
+}
+
+//SetSignalTimeProfile method
+//
+void ATLTileCalTBEventAction::SetSignalTimeProfile( G4bool enable ) {
+    fSignalTimeProfile.assign(enable ? fFrames : 0, 0.);
+}
+
+//ReportSignalTimeProfile method
+//
+void ATLTileCalTBEventAction::ReportSignalTimeProfile( G4int h1ID ) const {
+
+    const G4double total = std::accumulate(fSignalTimeProfile.begin(), fSignalTimeProfile.end(), 0.);
+    if ( total <= 0. ) return;
+
+    //Bin n holds the signal in ((n-1)*fBinTime, n*fBinTime]
+    auto analysisManager = G4AnalysisManager::Instance();
+    for ( std::size_t n = 0; n < fSignalTimeProfile.size(); ++n ) {
+        const G4double time = ( n > 0 ) ? (n - 0.5) * fBinTime : 0.;
+        analysisManager->FillH1(h1ID, time / ns, fSignalTimeProfile[n]);
+    }
+
+    //Fraction of the signal after a given time
+    auto GetLateFraction = [this, total]( G4double time ) -> G4double {
+        const std::size_t first = std::min(ATLTileCalTBDigitization::GetWindowBins(time, fBinTime, fFrames) + 1, fFrames);
+        return std::accumulate(fSignalTimeProfile.begin() + first, fSignalTimeProfile.end(), 0.) / total;
+    };
+
+    G4cout << "Signal time profile: " << GetLateFraction(0.75 * fTimeWindow) * 100.
+           << " % of the signal in the last quarter of the " << fTimeWindow / ns << " ns window" << G4endl;
+    for ( const auto& preset : ATLTileCalTBConstants::digi_presets ) {
+        if ( preset.time_window < fTimeWindow ) {
+            G4cout << "Signal time profile: " << GetLateFraction(preset.time_window) * 100.
+                   << " % of the signal would be lost with the " << preset.name << " preset" << G4endl;
+        }
+    }
+
+}
+
+//StartPipeline method
+//
+void ATLTileCalTBEventAction::StartPipeline( std::size_t noOfThreads, G4long runSeed ) {
+    //The pulses are written by the worker thread
+    if ( noOfThreads == 0 || fPulseOutput ) {
+        fPipeline.reset();
+        return;
+    }
+    const ATLTileCalTBOptimalFilter* optimalFilter = fNtuple.GetSampledReadout() ? &fNtuple.GetOptimalFilter() : nullptr;
+    if ( fNtuple.GetDigiVariants() ) {
+        fPipeline = std::make_unique<ATLTileCalTBDigiPipeline>(noOfThreads, runSeed, fDigitizer, fNoise, optimalFilter,
+                                                               fNtuple.GetVariantDigitizers(), fNtuple.GetVariantWindowBins());
+    }
+    else {
+        fPipeline = std::make_unique<ATLTileCalTBDigiPipeline>(noOfThreads, runSeed, fDigitizer, fNoise, optimalFilter);
+    }
+}
+
+//FinishPipeline method
+//
+void ATLTileCalTBEventAction::FinishPipeline() {
+    if ( !fPipeline ) return;
+    fPipeline->Finish([this](const ATLTileCalTBDigiPipeline::Event& event) { FillNtuple(event); });
+    fPipeline.reset();
+}
+
 //BeginOfEvent() method
 //
 void ATLTileCalTBEventAction::BeginOfEventAction([[maybe_unused]] const G4Event* event) {
     for ( auto& value : fAux ){ value = 0.; } 
-    for ( auto& value : fEdepVector ) { value = 0.; }
-    for ( auto& value : fSdepVector ) { value = 0.; }
-
-    #ifdef ATLTileCalTB_PulseOutput
-    auto runNumber = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
-    auto eventNumber = event->GetEventID();
-    pulse_event_path = std::filesystem::path("ATLTileCalTBpulse_Run" + std::to_string(runNumber) + "/Ev" + std::to_string(eventNumber));
-    std::filesystem::create_directory(pulse_event_path);
-    #endif
+    for ( auto& value : fNtuple.GetEdepVector() ) { value = 0.; }
+    for ( auto& value : fNtuple.GetSdepVector() ) { value = 0.; }
+
+    //Discard random numbers drawn before the engine was seeded for this event
+    fRandomBuffer->Reset();
+
+    if ( fPulseOutput ) {
+        auto runNumber = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+        auto eventNumber = event->GetEventID();
+        pulse_event_path = std::filesystem::path("ATLTileCalTBpulse_Run" + std::to_string(runNumber) + "/Ev" + std::to_string(eventNumber));
+        std::filesystem::create_directory(pulse_event_path);
+    }
     
-    #ifdef ATLTileCalTB_LEAKANALYSIS
-    SpectrumAnalyzer::GetInstance()->ClearEventFields();
-    #endif
+    if ( fSpectrumAnalyzer ) fSpectrumAnalyzer->ClearEventFields();
 }
 
 //GetHitsCollection method()
@@ -93,122 +198,170 @@ ATLTileCalTBHitsCollection* ATLTileCalTBEventAction::GetHitsCollection(G4int hcI
 
 }    
 
-//EndOfEventaction() method
+//DigitizeCell method
 //
-void ATLTileCalTBEventAction::EndOfEventAction( const G4Event* event ) {
+template<G4bool Noise, G4bool PulseOutput>
+G4double ATLTileCalTBEventAction::DigitizeCell( const ATLTileCalTBHit* hit ) {
 
-    auto analysisManager = G4AnalysisManager::Instance();
+    //Cells without deposits in this event only get the electronic noise
+    if ( !hit->HasSdep() ) {
+        if constexpr ( Noise ) return ATLTileCalTBDigitization::GetNoiseSignal(*fRandomBuffer);
+        else return 0.;
+    }
 
-    G4int counter = 0;
-    for ( auto& value : fAux ){ 
-        analysisManager->FillNtupleDColumn( counter, value );    
-        counter++;
-    }
-
-    //Method to convolute signal for PMT response
-    //From https://gitlab.cern.ch/allpix-squared/allpix-squared/-/blob/86fe21ad37d353e36a509a0827562ab7fadd5104/src/modules/CSADigitizer/CSADigitizerModule.cpp#L271-L283
-    auto ConvolutePMT = [](const std::array<G4double, ATLTileCalTBConstants::frames>& sdep) {
-        constexpr auto pmt_response_size = ATLTileCalTBConstants::pmt_response.size();
-        auto outvec = std::array<G4double, ATLTileCalTBConstants::frames>();
-        for (std::size_t k = 0; k < outvec.size(); ++k) {
-            G4double outsum = 0.;
-            auto jmax = (k >= pmt_response_size) ? pmt_response_size - 1 : k;
-            for (std::size_t j = 0; j <= jmax; ++j) {
-                outsum += sdep[k - j] * ATLTileCalTBConstants::pmt_response[j];
-            }
-            outvec[k] = outsum;
+    G4double peak_up = 0.;
+    G4double peak_down = 0.;
+    if constexpr ( PulseOutput ) {
+        //PMT response
+        ATLTileCalTBDigitization::Pulse sdep_up_v;
+        ATLTileCalTBDigitization::Pulse sdep_down_v;
+        fDigitizer.ConvolutePMT(hit->GetSdepUp(), hit->GetSdepBeginBin(), hit->GetSdepEndBin(), sdep_up_v);
+        fDigitizer.ConvolutePMT(hit->GetSdepDown(), hit->GetSdepBeginBin(), hit->GetSdepEndBin(), sdep_down_v);
+        WritePulse(hit->GetCellIndex(), sdep_up_v, sdep_down_v);
+        peak_up = *(std::max_element(sdep_up_v.begin(), sdep_up_v.end()));
+        peak_down = *(std::max_element(sdep_down_v.begin(), sdep_down_v.end()));
+    }
+    else {
+        //Peak of the PMT response, without the full pulse
+        peak_up = fDigitizer.GetPeak(hit->GetSdepUp(), hit->GetSdepBeginBin(), hit->GetSdepEndBin());
+        peak_down = fDigitizer.GetPeak(hit->GetSdepDown(), hit->GetSdepBeginBin(), hit->GetSdepEndBin());
+    }
+
+    //Electronic noise
+    if constexpr ( Noise ) return ATLTileCalTBDigitization::GetCellSignal(peak_up, peak_down, *fRandomBuffer);
+    else return peak_up + peak_down;
+
+}
+
+//WritePulse method
+//
+void ATLTileCalTBEventAction::WritePulse( std::size_t cell_index, const ATLTileCalTBDigitization::Pulse& sdep_up_v,
+                                          const ATLTileCalTBDigitization::Pulse& sdep_down_v ) const {
+
+    // Add signals
+    std::vector<G4double> sdep_sum_v(fFrames);
+    for (std::size_t n = 0; n < sdep_sum_v.size(); ++n) {
+        sdep_sum_v[n] = sdep_up_v[n] + sdep_down_v[n];
+    }
+
+    // Check that vector is not empty
+    if (std::accumulate(sdep_sum_v.begin(), sdep_sum_v.end(), 0.) != 0.) {
+        // Generate file name
+        const auto& cell = ATLTileCalTBGeometry::CellLUT::GetCell(cell_index);
+        std::ostringstream fileName;
+        fileName << pulse_event_path.string() << "/Mod";
+        switch (cell.module) {
+            case ATLTileCalTBGeometry::Module::LONG_LOWER:
+                fileName << "LL";
+                break;
+            case ATLTileCalTBGeometry::Module::LONG_UPPER:
+                fileName << "LU";
+                break;
+            case ATLTileCalTBGeometry::Module::EXTENDED:
+            case ATLTileCalTBGeometry::Module::EXTENDED_C10:
+            case ATLTileCalTBGeometry::Module::EXTENDED_D4:
+                fileName << "EX";
+                break;
         }
-        return outvec;
-    };
+        fileName << "_Cell" << cell.row << cell.nCell << ".dat";
 
-    //Method to get sdep from hit
-    auto GetSdep = [ConvolutePMT, this]
-    (const ATLTileCalTBHitsCollection* HC, std::size_t cell_index) -> G4double {
-        auto hit = (*HC)[cell_index];
+        // Open file and add cell label and bin width of the run preset
+        std::ofstream ofs;
+        ofs.open(fileName.str());
+        ofs << "# " << cell << "\n";
+        ofs << "# bin_time_ns " << fBinTime / ns << "\n";
 
-        //PMT response
-        auto sdep_up_v = ConvolutePMT(hit->GetSdepUp());
-        auto sdep_down_v = ConvolutePMT(hit->GetSdepDown());
-
-        //Create output pulses if requested
-        #ifdef ATLTileCalTB_PulseOutput
-        {
-            // Add signals
-            std::array<G4double, ATLTileCalTBConstants::frames> sdep_sum_v;
-            for (std::size_t n = 0; n < sdep_sum_v.size(); ++n) {
-                sdep_sum_v[n] = sdep_up_v[n] + sdep_down_v[n];
-            }
+        // Fill with values and close
+        for (auto val : sdep_sum_v) {
+            ofs << val << "\n";
+        }
+        ofs.close();
+    }
 
-            // Check that vector is not empty
-            if (std::accumulate(sdep_sum_v.begin(), sdep_sum_v.end(), 0) != 0.) {
-                // Generate file name
-                auto cell = ATLTileCalTBGeometry::CellLUT::GetInstance()->GetCell(cell_index);
-                std::ostringstream fileName;
-                fileName << pulse_event_path.string() << "/Mod";
-                switch (cell.module) {
-                    case ATLTileCalTBGeometry::Module::LONG_LOWER:
-                        fileName << "LL";
-                        break;
-                    case ATLTileCalTBGeometry::Module::LONG_UPPER:
-                        fileName << "LU";
-                        break;
-                    case ATLTileCalTBGeometry::Module::EXTENDED:
-                    case ATLTileCalTBGeometry::Module::EXTENDED_C10:
-                    case ATLTileCalTBGeometry::Module::EXTENDED_D4:
-                        fileName << "EX";
-                        break;
-                }
-                fileName << "_Cell" << cell.row << cell.nCell << ".dat";
-
-                // Open file and add cell label
-                std::ofstream ofs;
-                ofs.open(fileName.str());
-                ofs << "# " << cell << "\n";
-
-                // Fill with values and close
-                for (auto val : sdep_sum_v) {
-                    ofs << val << "\n";
-                }
-                ofs.close();
-            }
-        };
-        #endif
-
-        //Use maximum as signal
-        G4double sdep_up = *(std::max_element(sdep_up_v.begin(), sdep_up_v.end()));
-        G4double sdep_down = *(std::max_element(sdep_down_v.begin(), sdep_down_v.end()));
-
-        #ifdef ATLTileCalTB_NoNoise
-        return sdep_up + sdep_down;
-        #else
-        //Apply electronic noise
-        sdep_up += G4RandGauss::shoot(0., ATLTileCalTBConstants::signal_noise_sigma);
-        sdep_down += G4RandGauss::shoot(0., ATLTileCalTBConstants::signal_noise_sigma);
-
-        //Return sum if signal is larger than 2 * noise
-        auto sdep_sum = sdep_up + sdep_down;
-        return (sdep_sum > 2 * ATLTileCalTBConstants::signal_noise_sigma) ? sdep_sum : 0.;
-        #endif
-    };
+}
+
+//FillNtuple method
+//
+void ATLTileCalTBEventAction::FillNtuple( const ATLTileCalTBDigiPipeline::Event& event ) {
+    std::copy(event.edep.begin(), event.edep.end(), fNtuple.GetEdepVector().begin());
+    std::copy(event.sdep.begin(), event.sdep.end(), fNtuple.GetSdepVector().begin());
+    for (std::size_t v = 0; v < event.variantSdep.size(); ++v) {
+        std::copy(event.variantSdep[v].begin(), event.variantSdep[v].end(), fNtuple.GetVariantSdepVector(v).begin());
+    }
+    if ( fNtuple.GetSampledReadout() ) {
+        std::copy(event.samples.begin(), event.samples.end(), fNtuple.GetSamplesVector().begin());
+        std::copy(event.ofAmplitude.begin(), event.ofAmplitude.end(), fNtuple.GetOFAmplitudeVector().begin());
+        std::copy(event.ofTime.begin(), event.ofTime.end(), fNtuple.GetOFTimeVector().begin());
+    }
+    fNtuple.Fill(event.eLeak, event.eCal, event.eLate, event.pdgID, event.eBeam);
+}
+
+//EndOfEventaction() method
+//
+void ATLTileCalTBEventAction::EndOfEventAction( const G4Event* event ) {
 
-    //Get hits collections and fill vector
     auto HC = GetHitsCollection(0, event);
-    for (std::size_t n = 0; n < fNoOfCells; ++n) {
-        fEdepVector[n] = (*HC)[n]->GetEdep();
-        fSdepVector[n] = GetSdep(HC, n);
+    const G4int pdgID = fPrimaryGenAction->GetParticlenGun()->GetParticleDefinition()->GetPDGEncoding();
+    const G4double eBeam = fPrimaryGenAction->GetParticlenGun()->GetParticleEnergy();
+
+    //Signal time profile of the run
+    if ( !fSignalTimeProfile.empty() ) {
+        for (std::size_t n = 0; n < fNoOfCells; ++n) {
+            (*HC)[n]->ForEachSdepBin([this](std::size_t bin, G4double up, G4double down) {
+                fSignalTimeProfile[bin] += up + down;
+            });
+        }
     }
 
-    //Add sums to Ntuple
-    analysisManager->FillNtupleDColumn(2, std::accumulate(fEdepVector.begin(), fEdepVector.end(), 0));
-    analysisManager->FillNtupleDColumn(3, std::accumulate(fSdepVector.begin(), fSdepVector.end(), 0));
+    if ( fPipeline ) {
+        //Copy the signal of the touched cells and go back to the transport,
+        //the ntuple rows of the completed events are filled meanwhile
+        auto flush = [this](const ATLTileCalTBDigiPipeline::Event& digitized) { FillNtuple(digitized); };
+        auto& pipelineEvent = fPipeline->Acquire(flush);
+        pipelineEvent.eLeak = fAux[0];
+        pipelineEvent.eCal = fAux[1];
+        pipelineEvent.eLate = fAux[2];
+        pipelineEvent.pdgID = pdgID;
+        pipelineEvent.eBeam = eBeam;
+        pipelineEvent.eventID = event->GetEventID();
+        for (std::size_t n = 0; n < fNoOfCells; ++n) {
+            auto hit = (*HC)[n];
+            pipelineEvent.edep[n] = hit->GetEdep();
+            if ( hit->HasSdep() ) {
+                pipelineEvent.AddCell(n, hit->GetSdepUp(), hit->GetSdepDown(), hit->GetSdepBeginBin(), hit->GetSdepEndBin());
+            }
+        }
+        fPipeline->Submit(pipelineEvent);
+        fPipeline->Flush(flush);
+    }
+    else {
+        //Get hits collections and fill vector
+        auto& edepVector = fNtuple.GetEdepVector();
+        auto& sdepVector = fNtuple.GetSdepVector();
+        for (std::size_t n = 0; n < fNoOfCells; ++n) {
+            edepVector[n] = (*HC)[n]->GetEdep();
+            sdepVector[n] = (this->*fDigitizeCell)((*HC)[n]);
+        }
 
-    analysisManager->FillNtupleIColumn(6, fPrimaryGenAction->GetParticlenGun()->GetParticleDefinition()->GetPDGEncoding());
-    analysisManager->FillNtupleFColumn(7, fPrimaryGenAction->GetParticlenGun()->GetParticleEnergy());
+        //Digitization variants of the same hits
+        auto cellSignal = [HC](std::size_t n) {
+            const auto hit = (*HC)[n];
+            return ATLTileCalTBNtuple::CellSignal{hit->GetSdepUp(), hit->GetSdepDown(), hit->GetSdepBeginBin(), hit->GetSdepEndBin()};
+        };
+        fNtuple.DigitizeVariants(cellSignal, *fRandomBuffer);
+        fNtuple.ReadoutCells(cellSignal, fDigitizer, fNoise ? ATLTileCalTBConstants::signal_noise_sigma : 0., *fRandomBuffer);
 
-    analysisManager->AddNtupleRow();
+        fNtuple.Fill(fAux[0], fAux[1], fAux[2], pdgID, eBeam);
+    }
     
-    #ifdef ATLTileCalTB_LEAKANALYSIS
-    SpectrumAnalyzer::GetInstance()->FillEventFields();
+    if ( fSpectrumAnalyzer ) fSpectrumAnalyzer->FillEventFields();
+
+    #ifdef ATLTileCalTB_StepRecord
+    ATLTileCalTBStepRecorder::GetInstance()->WriteEvent(event->GetEventID(), fAux[0], fAux[1], fAux[2], pdgID, eBeam);
+    #endif
+    #ifdef ATLTileCalTB_FastSim
+    ATLTileCalTBShowerRecorder::GetInstance()->WriteEvent();
+    ATLTileCalTBEmShowerTuner::GetInstance()->EndOfEvent();
     #endif
 } 
 
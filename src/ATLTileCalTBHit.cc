@@ -14,16 +14,15 @@
 //Includers from Geant4
 #include "G4UnitsTable.hh"
 
+G4ThreadLocal G4Allocator<ATLTileCalTBHit>* ATLTileCalTBHitAllocator = nullptr;
+
 //Constructor and de-constructor
 //
-ATLTileCalTBHit::ATLTileCalTBHit()
+ATLTileCalTBHit::ATLTileCalTBHit( ATLTileCalTBSignalBuffer* signalBuffer, std::size_t cellIndex )
     : G4VHit(),
       fEdep(0.),
-      fSdepUp(),
-      fSdepDown() {
-    fSdepUp.fill(0.);
-    fSdepDown.fill(0.);
-
+      fSignalBuffer(signalBuffer),
+      fCellIndex(cellIndex) {
 }
 
 ATLTileCalTBHit::~ATLTileCalTBHit() {}
@@ -31,8 +30,8 @@ ATLTileCalTBHit::~ATLTileCalTBHit() {}
 ATLTileCalTBHit::ATLTileCalTBHit(const ATLTileCalTBHit& right)
     : G4VHit() {
     fEdep = right.fEdep;
-    fSdepUp = std::array<G4double, ATLTileCalTBConstants::frames>(right.fSdepUp);
-    fSdepDown = std::array<G4double, ATLTileCalTBConstants::frames>(right.fSdepDown);
+    fSignalBuffer = right.fSignalBuffer;
+    fCellIndex = right.fCellIndex;
 
 }
 
@@ -41,8 +40,8 @@ ATLTileCalTBHit::ATLTileCalTBHit(const ATLTileCalTBHit& right)
 const ATLTileCalTBHit& ATLTileCalTBHit::operator=(const ATLTileCalTBHit& right) {
   
     fEdep = right.fEdep;
-    fSdepUp = std::array<G4double, ATLTileCalTBConstants::frames>(right.fSdepUp);
-    fSdepDown = std::array<G4double, ATLTileCalTBConstants::frames>(right.fSdepDown);
+    fSignalBuffer = right.fSignalBuffer;
+    fCellIndex = right.fCellIndex;
 
     return *this;
 
@@ -0,0 +1,164 @@
+//**************************************************
+// \file ATLTileCalTBNtuple.cc
+// \brief: implementation of ATLTileCalTBNtuple
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBNtuple.hh"
+#include "ATLTileCalTBDigitization.hh"
+#include "ATLTileCalTBGeometry.hh"
+
+//Includers from Geant4
+//
+#include "G4Version.hh"
+#if G4VERSION_NUMBER < 1100
+#include "g4root.hh"  // replaced by G4AnalysisManager.h  in G4 v11 and up
+#else
+#include "G4AnalysisManager.hh"
+#endif
+
+//Includers from C++
+//
+#include <numeric>
+
+//Constructor
+//
+ATLTileCalTBNtuple::ATLTileCalTBNtuple()
+    : fNoOfCells(ATLTileCalTBGeometry::CellLUT::GetNumberOfCells()),
+      fEdepVector(fNoOfCells, 0.),
+      fSdepVector(fNoOfCells, 0.),
+      fDigiVariants(false),
+      fOptimalFilter(),
+      fSampledReadout(false),
+      fTopoClustering(),
+      fCellOutput(true),
+      fNtupleID(-1),
+      fELeakID(-1),
+      fEcalID(-1),
+      fEdepSumID(-1),
+      fSdepSumID(-1),
+      fPDGID(-1),
+      fEBeamID(-1),
+      fELateID(-1),
+      fVariantSdepSumIDs() {
+    for ( const auto& variant : ATLTileCalTBConstants::digi_variants ) {
+        fVariantDigitizers.emplace_back(ATLTileCalTBDigitization::GetPMTResponse(variant.kernel_stretch));
+        fVariantWindowBins.push_back(ATLTileCalTBDigitization::GetWindowBins(variant.time_window));
+        fVariantSdepVectors.emplace_back();
+    }
+}
+
+//Book method
+//
+void ATLTileCalTBNtuple::Book() {
+
+    auto analysisManager = G4AnalysisManager::Instance();
+
+    fNtupleID = analysisManager->CreateNtuple("ATLTileCalTBout", "ATLTileCalTBoutput");
+    fELeakID = analysisManager->CreateNtupleDColumn(fNtupleID, "ELeak");
+    fEcalID = analysisManager->CreateNtupleDColumn(fNtupleID, "Ecal");
+    fEdepSumID = analysisManager->CreateNtupleDColumn(fNtupleID, "EdepSum");
+    fSdepSumID = analysisManager->CreateNtupleDColumn(fNtupleID, "SdepSum");
+    analysisManager->CreateNtupleDColumn(fNtupleID, "Edep", fEdepVector);
+    analysisManager->CreateNtupleDColumn(fNtupleID, "Sdep", fSdepVector);
+    fPDGID = analysisManager->CreateNtupleIColumn(fNtupleID, "PDGID");
+    fEBeamID = analysisManager->CreateNtupleFColumn(fNtupleID, "EBeam");
+    fELateID = analysisManager->CreateNtupleDColumn(fNtupleID, "ELate");
+    //Digitization variants, the cell vectors are empty unless enabled for the run
+    fVariantSdepSumIDs.clear();
+    for ( std::size_t v = 0; v < ATLTileCalTBConstants::digi_variants.size(); ++v ) {
+        const G4String name = ATLTileCalTBConstants::digi_variants[v].name;
+        fVariantSdepSumIDs.push_back(analysisManager->CreateNtupleDColumn(fNtupleID, "SdepSum_" + name));
+        analysisManager->CreateNtupleDColumn(fNtupleID, "Sdep_" + name, fVariantSdepVectors[v]);
+    }
+    //Sampled readout, empty unless enabled for the run
+    analysisManager->CreateNtupleFColumn(fNtupleID, "Samples", fSamplesVector);
+    analysisManager->CreateNtupleDColumn(fNtupleID, "OFAmplitude", fOFAmplitudeVector);
+    analysisManager->CreateNtupleDColumn(fNtupleID, "OFTime", fOFTimeVector);
+    //Topological clusters, by decreasing energy
+    analysisManager->CreateNtupleDColumn(fNtupleID, "ClusterE", fClusterEVector);
+    analysisManager->CreateNtupleIColumn(fNtupleID, "ClusterNCells", fClusterNCellsVector);
+    analysisManager->CreateNtupleIColumn(fNtupleID, "ClusterSeed", fClusterSeedVector);
+    analysisManager->FinishNtuple(fNtupleID);
+
+}
+
+//SetLayout method
+//
+void ATLTileCalTBNtuple::SetLayout( G4double binTime, std::size_t frames ) {
+    fOptimalFilter = ATLTileCalTBOptimalFilter(ATLTileCalTBDigitization::GetPMTResponse(1., binTime), binTime);
+    for ( std::size_t v = 0; v < ATLTileCalTBConstants::digi_variants.size(); ++v ) {
+        const auto& variant = ATLTileCalTBConstants::digi_variants[v];
+        fVariantDigitizers[v] = ATLTileCalTBDigitizer(ATLTileCalTBDigitization::GetPMTResponse(variant.kernel_stretch, binTime), frames);
+        fVariantWindowBins[v] = ATLTileCalTBDigitization::GetWindowBins(variant.time_window, binTime, frames);
+    }
+}
+
+//SetSampledReadout method
+//
+void ATLTileCalTBNtuple::SetSampledReadout( G4bool sampledReadout ) {
+    fSampledReadout = sampledReadout;
+    fSamplesVector.assign(sampledReadout ? fNoOfCells * 2 * ATLTileCalTBConstants::readout_samples : 0, 0.f);
+    fOFAmplitudeVector.assign(sampledReadout ? fNoOfCells : 0, 0.);
+    fOFTimeVector.assign(sampledReadout ? fNoOfCells : 0, 0.);
+}
+
+//SetDigiVariants method
+//
+void ATLTileCalTBNtuple::SetDigiVariants( G4bool digiVariants ) {
+    fDigiVariants = digiVariants;
+    for ( auto& sdepVector : fVariantSdepVectors ) sdepVector.assign(digiVariants ? fNoOfCells : 0, 0.);
+}
+
+//Fill method
+//
+void ATLTileCalTBNtuple::Fill( G4double eLeak, G4double eCal, G4double eLate, G4int pdgID, G4double eBeam ) {
+
+    auto analysisManager = G4AnalysisManager::Instance();
+
+    analysisManager->FillNtupleDColumn(fNtupleID, fELeakID, eLeak);
+    analysisManager->FillNtupleDColumn(fNtupleID, fEcalID, eCal);
+
+    //Add sums to Ntuple (the cell vectors are bound to the Edep and Sdep columns)
+    analysisManager->FillNtupleDColumn(fNtupleID, fEdepSumID, std::accumulate(fEdepVector.begin(), fEdepVector.end(), 0.));
+    analysisManager->FillNtupleDColumn(fNtupleID, fSdepSumID, std::accumulate(fSdepVector.begin(), fSdepVector.end(), 0.));
+
+    analysisManager->FillNtupleIColumn(fNtupleID, fPDGID, pdgID);
+    analysisManager->FillNtupleFColumn(fNtupleID, fEBeamID, eBeam);
+    analysisManager->FillNtupleDColumn(fNtupleID, fELateID, eLate);
+
+    //Digitization variants of the same hits (0 if disabled)
+    for ( std::size_t v = 0; v < fVariantSdepSumIDs.size(); ++v ) {
+        const auto& sdepVector = fVariantSdepVectors[v];
+        analysisManager->FillNtupleDColumn(fNtupleID, fVariantSdepSumIDs[v], std::accumulate(sdepVector.begin(), sdepVector.end(), 0.));
+    }
+
+    //Topological clusters of the nominal cell signals
+    fClusterEVector.clear();
+    fClusterNCellsVector.clear();
+    fClusterSeedVector.clear();
+    for ( const auto& cluster : fTopoClustering.Run(fSdepVector) ) {
+        fClusterEVector.push_back(cluster.energy);
+        fClusterNCellsVector.push_back(cluster.noOfCells);
+        fClusterSeedVector.push_back(cluster.seed);
+    }
+
+    //The cell vectors are written empty if disabled (capacity kept for the next event)
+    if ( !fCellOutput ) {
+        fEdepVector.clear();
+        fSdepVector.clear();
+    }
+    analysisManager->AddNtupleRow(fNtupleID);
+    if ( !fCellOutput ) {
+        fEdepVector.assign(fNoOfCells, 0.);
+        fSdepVector.assign(fNoOfCells, 0.);
+    }
+
+}
+
+//**************************************************
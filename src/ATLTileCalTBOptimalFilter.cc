@@ -0,0 +1,163 @@
+//**************************************************
+// \file ATLTileCalTBOptimalFilter.cc
+// \brief: implementation of ATLTileCalTBOptimalFilter
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBOptimalFilter.hh"
+
+//Includers from Geant4
+//
+#include "G4Exception.hh"
+
+//Includers from C++
+//
+#include <algorithm>
+#include <cmath>
+
+//Constructors
+//
+ATLTileCalTBOptimalFilter::ATLTileCalTBOptimalFilter()
+    : ATLTileCalTBOptimalFilter(std::vector<G4double>(ATLTileCalTBConstants::pmt_response.begin(),
+                                                      ATLTileCalTBConstants::pmt_response.end()),
+                                ATLTileCalTBConstants::frame_bin_time) {
+}
+
+ATLTileCalTBOptimalFilter::ATLTileCalTBOptimalFilter( const std::vector<G4double>& kernel, G4double binTime )
+    : fKernel(kernel),
+      fBinTime(binTime),
+      fSampleTimes(),
+      fSamplePositions(),
+      fWeights() {
+
+    if ( fKernel.size() < 2 || fBinTime <= 0. ) {
+        G4ExceptionDescription msg;
+        msg << "Optimal filter needs a PMT response with at least 2 values and a positive bin width";
+        G4Exception("ATLTileCalTBOptimalFilter::ATLTileCalTBOptimalFilter()", "MyCode0013", FatalException, msg);
+    }
+
+    //Normalize the PMT response to its maximum
+    const auto peak = std::max_element(fKernel.begin(), fKernel.end());
+    const G4double peakTime = (peak - fKernel.begin()) * fBinTime;
+    const G4double peakValue = *peak;
+    for ( auto& value : fKernel ) value /= peakValue;
+
+    //Sample times, the central one at the peak for a signal at t = 0
+    constexpr std::size_t noOfSamples = ATLTileCalTBConstants::readout_samples;
+    for ( std::size_t k = 0; k < noOfSamples; ++k ) {
+        fSampleTimes[k] = peakTime + (static_cast<G4double>(k) - 0.5 * (noOfSamples - 1)) * ATLTileCalTBConstants::readout_sample_period;
+        fSamplePositions[k] = fSampleTimes[k] / fBinTime;
+    }
+
+    //Weights from the constraints sum a_k g_k = 1, sum a_k g'_k = 0,
+    //sum b_k g_k = 0 and sum b_k g'_k = -1 (g shifted by the phase)
+    const std::size_t noOfPhases = static_cast<std::size_t>(
+        std::lround(2. * ATLTileCalTBConstants::readout_max_phase / ATLTileCalTBConstants::readout_phase_step)) + 1;
+    fWeights.resize(noOfPhases);
+    for ( std::size_t p = 0; p < noOfPhases; ++p ) {
+        const G4double phase = -ATLTileCalTBConstants::readout_max_phase + p * ATLTileCalTBConstants::readout_phase_step;
+        Samples g;
+        Samples dg;
+        for ( std::size_t k = 0; k < noOfSamples; ++k ) {
+            const G4double time = fSampleTimes[k] - phase;
+            g[k] = GetShape(time);
+            dg[k] = (GetShape(time + fBinTime) - GetShape(time - fBinTime)) / (2. * fBinTime);
+        }
+        G4double gg = 0.;
+        G4double gdg = 0.;
+        G4double dgdg = 0.;
+        for ( std::size_t k = 0; k < noOfSamples; ++k ) {
+            gg += g[k] * g[k];
+            gdg += g[k] * dg[k];
+            dgdg += dg[k] * dg[k];
+        }
+        const G4double det = gg * dgdg - gdg * gdg;
+        auto& weights = fWeights[p];
+        for ( std::size_t k = 0; k < noOfSamples; ++k ) {
+            weights.amplitude[k] = ( det > 0. ) ? (dgdg * g[k] - gdg * dg[k]) / det : 0.;
+            weights.time[k] = ( det > 0. ) ? (gdg * g[k] - gg * dg[k]) / det : 0.;
+        }
+    }
+
+}
+
+//GetShape method
+//
+G4double ATLTileCalTBOptimalFilter::GetShape( G4double time ) const {
+    const G4double position = time / fBinTime;
+    if ( position < 0. || position >= static_cast<G4double>(fKernel.size() - 1) ) return 0.;
+    const std::size_t index = static_cast<std::size_t>(position);
+    const G4double fraction = position - index;
+    return fKernel[index] + fraction * (fKernel[index + 1] - fKernel[index]);
+}
+
+//Reconstruct method
+//
+ATLTileCalTBOptimalFilter::Result ATLTileCalTBOptimalFilter::Reconstruct( const G4double* samples, G4double minAmplitude ) const {
+
+    //Iterate on the phase, starting from the in-time weights
+    const G4double step = ATLTileCalTBConstants::readout_phase_step;
+    const G4double maxPhase = ATLTileCalTBConstants::readout_max_phase;
+    std::size_t index = fWeights.size() / 2;
+    Result result{0., 0.};
+    for ( std::size_t iteration = 0; iteration < 3; ++iteration ) {
+        const auto& weights = fWeights[index];
+        G4double amplitude = 0.;
+        G4double amplitudeTime = 0.;
+        for ( std::size_t k = 0; k < weights.amplitude.size(); ++k ) {
+            amplitude += weights.amplitude[k] * samples[k];
+            amplitudeTime += weights.time[k] * samples[k];
+        }
+        if ( amplitude <= minAmplitude ) return {amplitude, 0.};
+
+        result.amplitude = amplitude;
+        result.time = -maxPhase + index * step + amplitudeTime / amplitude;
+
+        const G4double phase = std::clamp(result.time, -maxPhase, maxPhase);
+        const std::size_t next = static_cast<std::size_t>(std::lround((phase + maxPhase) / step));
+        if ( next == index ) break;
+        index = next;
+    }
+    return result;
+
+}
+
+//ReadoutCell method
+//
+ATLTileCalTBOptimalFilter::Result ATLTileCalTBOptimalFilter::ReadoutCell( ATLTileCalTBDigitizer& digitizer,
+    const ATLTileCalTBConstants::signal_t* sdepUp, const ATLTileCalTBConstants::signal_t* sdepDown,
+    std::size_t begin, std::size_t end, G4double noiseSigma, ATLTileCalTBRandomBuffer& random, G4float* samples ) const {
+
+    const std::array<const ATLTileCalTBConstants::signal_t*, 2> sdep{sdepUp, sdepDown};
+    //The time of a PMT compatible with noise is not used
+    const G4double minAmplitude = 2. * noiseSigma;
+
+    Result cell{0., 0.};
+    G4double weightedTime = 0.;
+    G4double timeWeight = 0.;
+    for ( std::size_t pmt = 0; pmt < sdep.size(); ++pmt ) {
+        Samples pmtSamples;
+        digitizer.GetSamples(sdep[pmt], begin, end, fSamplePositions.data(), pmtSamples.size(), pmtSamples.data());
+        if ( noiseSigma > 0. ) {
+            for ( auto& sample : pmtSamples ) sample = random.Gauss(sample, noiseSigma);
+        }
+        std::copy(pmtSamples.begin(), pmtSamples.end(), samples + pmt * pmtSamples.size());
+
+        const Result result = Reconstruct(pmtSamples.data(), minAmplitude);
+        cell.amplitude += result.amplitude;
+        if ( result.amplitude > minAmplitude ) {
+            weightedTime += result.amplitude * result.time;
+            timeWeight += result.amplitude;
+        }
+    }
+    if ( timeWeight > 0. ) cell.time = weightedTime / timeWeight;
+    return cell;
+
+}
+
+//**************************************************
@@ -0,0 +1,89 @@
+//**************************************************
+// \file ATLTileCalTBPeriodLayouts.cc
+// \brief: implementation of ATLTileCalTBPeriodLayouts
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBPeriodLayouts.hh"
+
+//Includers from Geant4
+//
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4VTouchable.hh"
+#include "G4ThreeVector.hh"
+
+//Includers from C++
+//
+#include <algorithm>
+#include <cmath>
+
+//Constructor
+//
+ATLTileCalTBPeriodLayouts::ATLTileCalTBPeriodLayouts()
+    : fLayouts() {
+
+    auto LVStore = G4LogicalVolumeStore::GetInstance();
+    for(auto volume : *LVStore) {
+
+        if( volume->GetName()!="Tile::Period" ) continue;
+        G4ThreeVector min, max;
+        volume->GetSolid()->BoundingLimits( min, max );
+        Layout layout{ max.x() - min.x(), {} };
+        for( std::size_t i=0; i<volume->GetNoDaughters(); i++ ) {
+            const auto wrapper = volume->GetDaughter(i);
+            if( wrapper->GetLogicalVolume()->GetName()!="Tile::Wrapper" || wrapper->GetLogicalVolume()->GetNoDaughters()==0 ) continue;
+            const auto scintillator = wrapper->GetLogicalVolume()->GetDaughter(0);
+            G4ThreeVector scintillatorMin, scintillatorMax;
+            scintillator->GetLogicalVolume()->GetSolid()->BoundingLimits( scintillatorMin, scintillatorMax );
+            layout.tiles.push_back( Tile{ scintillator->GetCopyNo(), wrapper->GetTranslation().x(), wrapper->GetTranslation().z(),
+                                          std::max( -scintillatorMin.y(), scintillatorMax.y() ),
+                                          std::max( -scintillatorMin.z(), scintillatorMax.z() ) } );
+        }
+        if( !layout.tiles.empty() ) fLayouts.emplace( volume, std::move(layout) );
+
+    }
+
+}
+
+//FindPeriodDepth method
+//
+G4int ATLTileCalTBPeriodLayouts::FindPeriodDepth( const G4VTouchable* touchable ) const {
+    const G4int depth = touchable->GetHistoryDepth();
+    for ( G4int d = 0; d + 3 <= depth; ++d ) {
+        if ( Find( touchable->GetVolume(d)->GetLogicalVolume() ) ) return d;
+    }
+    return -1;
+}
+
+//FindTile method
+//
+const ATLTileCalTBPeriodLayouts::Tile* ATLTileCalTBPeriodLayouts::Layout::FindTile( G4int row ) const {
+    for ( const auto& tile : tiles ) {
+        if ( tile.row == row ) return &tile;
+    }
+    return nullptr;
+}
+
+//FindClosestTile method
+//
+const ATLTileCalTBPeriodLayouts::Tile& ATLTileCalTBPeriodLayouts::Layout::FindClosestTile( G4double z ) const {
+    return *std::min_element( tiles.begin(), tiles.end(), [z](const Tile& a, const Tile& b) {
+        return std::abs( a.z - z ) < std::abs( b.z - z ); } );
+}
+
+//GetPhase method
+//
+G4double ATLTileCalTBPeriodLayouts::Layout::GetPhase( const Tile& tile, G4double x ) const {
+    const G4double phase = ( x - tile.x ) / pitch;
+    return phase - std::floor( phase );
+}
+
+//**************************************************
@@ -0,0 +1,60 @@
+//**************************************************
+// \file ATLTileCalTBRandomBuffer.cc
+// \brief: implementation of ATLTileCalTBRandomBuffer
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBRandomBuffer.hh"
+
+//Includers from Geant4
+//
+#include "Randomize.hh"
+#include "G4PhysicalConstants.hh"
+
+//Constructor
+//
+ATLTileCalTBRandomBuffer::ATLTileCalTBRandomBuffer( CLHEP::HepRandomEngine* engine )
+    : fEngine(engine),
+      fFlat(),
+      fNextFlat(fBlockSize),
+      fGauss(),
+      fNextGauss(fBlockSize) {
+}
+
+//Reset method
+//
+void ATLTileCalTBRandomBuffer::Reset() {
+    fNextFlat = fBlockSize;
+    fNextGauss = fBlockSize;
+}
+
+//FillFlat method
+//
+void ATLTileCalTBRandomBuffer::FillFlat() {
+    ( fEngine ? fEngine : G4Random::getTheEngine() )->flatArray(fBlockSize, fFlat.data());
+    fNextFlat = 0;
+}
+
+//FillGauss method
+//Box-Muller on a block of uniforms, two gaussians per pair
+//
+void ATLTileCalTBRandomBuffer::FillGauss() {
+    static_assert(fBlockSize % 2 == 0, "Box-Muller needs an even block size");
+
+    ( fEngine ? fEngine : G4Random::getTheEngine() )->flatArray(fBlockSize, fGauss.data());
+    for ( std::size_t i = 0; i < fBlockSize; i += 2 ) {
+        //1-u is in (0,1], the logarithm stays finite
+        const G4double r = std::sqrt(-2. * std::log(1. - fGauss[i]));
+        const G4double phi = CLHEP::twopi * fGauss[i + 1];
+        fGauss[i] = r * std::cos(phi);
+        fGauss[i + 1] = r * std::sin(phi);
+    }
+    fNextGauss = 0;
+}
+
+//**************************************************
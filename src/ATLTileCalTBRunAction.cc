@@ -10,17 +10,35 @@
 //Includers from project files
 //
 #include "ATLTileCalTBRunAction.hh"
+#include "ATLTileCalTBConstants.hh"
 #include "ATLTileCalTBEventAction.hh"
-#ifdef ATLTileCalTB_LEAKANALYSIS
+#include "ATLTileCalTBRunMessenger.hh"
+#include "ATLTileCalTBSensDet.hh"
+#include "ATLTileCalTBStepAction.hh"
+#include "ATLTileCalTBStackingAction.hh"
+#include "ATLTileCalTBEmPresets.hh"
 #include "SpectrumAnalyzer.hh"
+#ifdef ATLTileCalTB_StepRecord
+#include "ATLTileCalTBStepRecord.hh"
+#endif
+#ifdef ATLTileCalTB_FastSim
+#include "ATLTileCalTBShowerLibrary.hh"
+#include "ATLTileCalTBEmShower.hh"
 #endif
 
 //Includers from Geant4
 //
 #include "G4Run.hh"
 #include "G4RunManager.hh"
+#include "G4SDManager.hh"
+#include "G4ProcessTable.hh"
+#include "G4NeutronKiller.hh"
+#include "G4Neutron.hh"
+#include "G4ParticleTable.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
 #include "G4Version.hh"
+#include "Randomize.hh"
 #if G4VERSION_NUMBER < 1100
 #include "g4root.hh"  // replaced by G4AnalysisManager.h  in G4 v11 and up
 #else
@@ -29,13 +47,41 @@
 
 //Includers from C++
 //
+#include <algorithm>
 #include <filesystem>
+#include <limits>
+
+//Seed of the digitization threads of the current run
+//
+G4long ATLTileCalTBRunAction::fRunSeed = 0;
 
 //Constructor and de-constructor
 //
-ATLTileCalTBRunAction::ATLTileCalTBRunAction( ATLTileCalTBEventAction* eventAction )
+ATLTileCalTBRunAction::ATLTileCalTBRunAction( ATLTileCalTBEventAction* eventAction, ATLTileCalTBStackingAction* stackingAction,
+                                              ATLTileCalTBStepAction* stepAction )
     : G4UserRunAction(),
-      fEventAction(eventAction) { 
+      fEventAction(eventAction),
+      fStackingAction(stackingAction),
+      fStepAction(stepAction),
+      fMessenger(new ATLTileCalTBRunMessenger(this)),
+      fNoise(true),
+      fPulseOutput(false),
+      fLeakAnalysis(false),
+      fDigiPreset(ATLTileCalTBConstants::digi_presets.front().name),
+      fTimeProfile(false),
+      fDigiThreads(0),
+      fSampledReadout(false),
+      fCellOutput(true),
+      fDigiVariants(false),
+      fTimeCut(true),
+      fRoulette(),
+      fNonInteracting(ATLTileCalTBConstants::non_interacting_particles.begin(),
+                      ATLTileCalTBConstants::non_interacting_particles.end()),
+      fLibraryFile(),
+      fEmShowerTuning(false),
+      fSpectrumNtupleID(-1),
+      fSignalTimeH1ID(-1),
+      fRunInfoNtupleID(-1) { 
     
     //Printing event number per each event
     //
@@ -54,23 +100,29 @@ ATLTileCalTBRunAction::ATLTileCalTBRunAction( ATLTileCalTBEventAction* eventActi
   
     // Creating ntuple
     //
-    analysisManager->CreateNtuple("ATLTileCalTBout", "ATLTileCalTBoutput");
-    analysisManager->CreateNtupleDColumn("ELeak");
-    analysisManager->CreateNtupleDColumn("Ecal");
-    analysisManager->CreateNtupleDColumn("EdepSum");
-    analysisManager->CreateNtupleDColumn("SdepSum");
-    analysisManager->CreateNtupleDColumn("Edep", fEventAction->GetEdepVector());
-    analysisManager->CreateNtupleDColumn("Sdep", fEventAction->GetSdepVector());
-    analysisManager->CreateNtupleIColumn("PDGID");
-    analysisManager->CreateNtupleFColumn("EBeam");
-    analysisManager->FinishNtuple();
+    fEventAction->GetNtuple().Book();
     
-    #ifdef ATLTileCalTB_LEAKANALYSIS
+    //The leakage spectrum ntuple is only written if enabled for the run
+    //
+    analysisManager->SetActivation(true);
     SpectrumAnalyzer::GetInstance()->CreateNtupleAndScorer("ke");
-    #endif
+    fSpectrumNtupleID = SpectrumAnalyzer::GetInstance()->GetNtupleID();
+
+    //Settings of the run, one row per run
+    //
+    fRunInfoNtupleID = analysisManager->CreateNtuple("RunInfo", "ATLTileCalTB settings");
+    analysisManager->CreateNtupleSColumn(fRunInfoNtupleID, "EmPreset");
+    analysisManager->FinishNtuple(fRunInfoNtupleID);
+
+    //Signal vs time of all cells, only written if enabled for the run
+    //
+    fSignalTimeH1ID = analysisManager->CreateH1("SignalTime", "Binned signal vs time [ns]",
+                                                ATLTileCalTBConstants::frames, 0.,
+                                                ATLTileCalTBConstants::frame_time_window / ns);
 }
 
 ATLTileCalTBRunAction::~ATLTileCalTBRunAction() {
+    delete fMessenger;
     #if G4VERSION_NUMBER < 1100
     delete G4AnalysisManager::Instance();  // not needed for G4 v11 and up
     #endif
@@ -86,35 +138,209 @@ void ATLTileCalTBRunAction::BeginOfRunAction(const G4Run* run) {
   
     auto analysisManager = G4AnalysisManager::Instance();
 
+    //Set the modes of this run, before opening the file
+    //
+    fEventAction->SetRunModes(fNoise, fPulseOutput, fLeakAnalysis);
+    analysisManager->SetNtupleActivation(fSpectrumNtupleID, fLeakAnalysis);
+    analysisManager->SetH1Activation(fSignalTimeH1ID, fTimeProfile);
+
+    //Time binning of the run, the sensitive detector only exists on
+    //threads processing events
+    //
+    const auto& presets = ATLTileCalTBConstants::digi_presets;
+    auto preset = std::find_if(presets.begin(), presets.end(),
+                               [this](const auto& p) { return fDigiPreset == p.name; });
+    if ( preset == presets.end() ) preset = presets.begin();  // names are checked by the messenger
+    fEventAction->SetLayout(preset->bin_time, preset->time_window);
+    fEventAction->SetSignalTimeProfile(fTimeProfile);
+    fEventAction->GetNtuple().SetSampledReadout(fSampledReadout);
+    fEventAction->GetNtuple().SetCellOutput(fCellOutput);
+    fEventAction->GetNtuple().SetNoise(fNoise);
+    fEventAction->GetNtuple().SetDigiVariants(fDigiVariants);
+    auto sensDet = static_cast<ATLTileCalTBSensDet*>(
+        G4SDManager::GetSDMpointer()->FindSensitiveDetector("caloSD", false));
+    if ( sensDet ) sensDet->SetLayout(preset->bin_time, preset->time_window);
+
+    //Tracks are killed after the time window of the signal and a margin, the neutrons
+    //in flight by the neutron killer of the physics list (if any, threads processing events only).
+    //The step records cover the nominal time window whatever the preset
+    //
+    #ifdef ATLTileCalTB_StepRecord
+    const G4double trackedWindow = ATLTileCalTBConstants::frame_time_window;
+    #else
+    const G4double trackedWindow = preset->time_window;
+    #endif
+    const G4double timeCut = fTimeCut ? trackedWindow + ATLTileCalTBConstants::late_track_margin
+                                      : std::numeric_limits<G4double>::max();
+    fEventAction->SetTimeCut(timeCut);
+    if ( !IsMaster() || !G4Threading::IsMultithreadedApplication() ) {
+        auto neutronKiller = dynamic_cast<G4NeutronKiller*>(
+            G4ProcessTable::GetProcessTable()->FindProcess("nKiller", G4Neutron::Definition()));
+        if ( neutronKiller ) {
+            neutronKiller->SetTimeLimit(fTimeCut ? timeCut : ATLTileCalTBConstants::neutron_killer_time_limit);
+        }
+    }
+
+    //Non-interacting particles and Russian roulette of the new tracks (threads processing events only)
+    //
+    if ( fStackingAction ) {
+        fStackingAction->ClearNonInteracting();
+        for ( const auto& name : fNonInteracting ) {
+            const auto particle = G4ParticleTable::GetParticleTable()->FindParticle(name);
+            if ( !particle ) {
+                G4ExceptionDescription msg;
+                msg << "Unknown particle " << name << ", it is transported";
+                G4Exception("ATLTileCalTBRunAction::BeginOfRunAction()", "MyCode0016", JustWarning, msg);
+                continue;
+            }
+            fStackingAction->AddNonInteracting(particle);
+        }
+        fStackingAction->ClearRoulette();
+        for ( const auto& roulette : fRoulette ) {
+            const auto particle = G4ParticleTable::GetParticleTable()->FindParticle(roulette.particle);
+            if ( !particle ) {
+                G4ExceptionDescription msg;
+                msg << "Unknown particle " << roulette.particle << ", no Russian roulette for it";
+                G4Exception("ATLTileCalTBRunAction::BeginOfRunAction()", "MyCode0015", JustWarning, msg);
+                continue;
+            }
+            fStackingAction->AddRoulette(particle, roulette.threshold, roulette.survival);
+        }
+    }
+
+    //Volume roles for the calo energy of the stepping action (threads processing events only)
+    //
+    if ( fStepAction ) fStepAction->BuildVolumeRoles();
+
+    //Digitization threads of this worker (the master does not process events in MT mode),
+    //their seed is set by the master from its engine seed and the run ID before the
+    //workers start the run, no number is drawn from the transport engines
+    //
+    if ( IsMaster() ) fRunSeed = ATLTileCalTBDigiPipeline::GetSeed(G4Random::getTheSeed(), run->GetRunID());
+    if ( !IsMaster() || !G4Threading::IsMultithreadedApplication() ) fEventAction->StartPipeline(fDigiThreads, fRunSeed);
+
     std::string runnumber = std::to_string( run->GetRunID() );
     G4String fileName = "ATLTileCalTBout_Run" + runnumber + ".root";
     analysisManager->OpenFile(fileName);
 
+    //Run settings, filled by a single thread
+    //
+    const G4bool firstThread = G4Threading::IsMultithreadedApplication() ? G4Threading::G4GetThreadId() == 0 : true;
+    if ( firstThread ) {
+        analysisManager->FillNtupleSColumn(fRunInfoNtupleID, 0, ATLTileCalTBEmPresets::GetActive());
+        analysisManager->AddNtupleRow(fRunInfoNtupleID);
+    }
+
     //Print useful information
     //
     if (IsMaster()) {
         G4cout << "Using " << analysisManager->GetType() << G4endl;
-        #ifdef ATLTileCalTB_PulseOutput
-        G4cout << "Creating pulse plots" << G4endl;
+        if ( fPulseOutput ) G4cout << "Creating pulse plots" << G4endl;
+        if ( !fNoise ) G4cout << "Electronic noise disabled" << G4endl;
+        if ( fLeakAnalysis ) G4cout << "Leakage spectrum analysis enabled" << G4endl;
+        G4cout << "EM parameters preset " << ATLTileCalTBEmPresets::GetActive() << G4endl;
+        G4cout << "Signal binning " << preset->name << ": " << preset->bin_time / ns << " ns bins up to "
+               << preset->time_window / ns << " ns" << G4endl;
+        if ( fTimeProfile ) G4cout << "Filling the signal time profile" << G4endl;
+        if ( fTimeCut ) G4cout << "Killing the tracks after " << timeCut / ns << " ns" << G4endl;
+        if ( !fNonInteracting.empty() ) {
+            G4cout << "Killing as leaking at creation:";
+            for ( const auto& name : fNonInteracting ) G4cout << " " << name;
+            G4cout << G4endl;
+        }
+        for ( const auto& roulette : fRoulette ) {
+            G4cout << "Russian roulette on " << roulette.particle << " below " << roulette.threshold / MeV
+                   << " MeV, survival probability " << roulette.survival << G4endl;
+        }
+        if ( fSampledReadout ) G4cout << "Writing the sampled readout and optimal filter reconstruction" << G4endl;
+        if ( !fCellOutput ) G4cout << "Cell vectors disabled, writing the sums and clusters only" << G4endl;
+        if ( fDigiThreads > 0 ) {
+            if ( fPulseOutput ) G4cout << "Digitization threads disabled by the pulse output" << G4endl;
+            else G4cout << "Digitizing on " << fDigiThreads << " threads per worker" << G4endl;
+        }
+        if ( fDigiVariants ) {
+            G4cout << "Writing " << ATLTileCalTBConstants::digi_variants.size() << " digitization variants" << G4endl;
+        }
+        #ifdef ATLTileCalTB_StepRecord
+        G4cout << "Writing step records for re-digitization" << G4endl;
         #endif
-        #ifdef ATLTileCalTB_NoNoise
-        G4cout << "Electronic noise disabled" << G4endl;
+        #ifdef ATLTileCalTB_FastSim
+        const auto library = ATLTileCalTBShowerLibrary::GetInstance();
+        if ( !fLibraryFile.empty() ) {
+            G4cout << "Generating the shower library " << fLibraryFile << " below " << library->GetMaxEnergy() / MeV << " MeV" << G4endl;
+        }
+        else if ( !library->IsEmpty() ) {
+            G4cout << "Shower library of " << library->GetNumberOfEntries() << " entries below "
+                   << library->GetMaxEnergy() / MeV << " MeV" << G4endl;
+        }
+        if ( fEmShowerTuning ) G4cout << "Tuning the parameterized EM showers on the primary e+-" << G4endl;
+        else if ( ATLTileCalTBEmShower::GetInstance()->IsEnabled() ) G4cout << "Parameterized EM showers of the primary e+-" << G4endl;
         #endif
     }
 
     auto pulse_run_path = std::filesystem::path("ATLTileCalTBpulse_Run" + runnumber);
     std::filesystem::remove_all(pulse_run_path);
-    #ifdef ATLTileCalTB_PulseOutput
-    std::filesystem::create_directory(pulse_run_path);
+    if ( fPulseOutput ) std::filesystem::create_directory(pulse_run_path);
+
+    //Open step record file of this thread (the master does not process events in MT mode)
+    //
+    #ifdef ATLTileCalTB_StepRecord
+    if ( !IsMaster() || !G4Threading::IsMultithreadedApplication() ) {
+        G4String stepFileName = "ATLTileCalTBsteps_Run" + runnumber;
+        if ( G4Threading::G4GetThreadId() >= 0 ) stepFileName += "_t" + std::to_string( G4Threading::G4GetThreadId() );
+        ATLTileCalTBStepRecorder::GetInstance()->OpenFile(stepFileName + ".bin");
+    }
+    #endif
+
+    //Open shower library file of this thread in generation mode
+    //
+    #ifdef ATLTileCalTB_FastSim
+    if ( !fLibraryFile.empty() && ( !IsMaster() || !G4Threading::IsMultithreadedApplication() ) ) {
+        G4String libraryFileName = fLibraryFile + "_Run" + runnumber;
+        if ( G4Threading::G4GetThreadId() >= 0 ) libraryFileName += "_t" + std::to_string( G4Threading::G4GetThreadId() );
+        ATLTileCalTBShowerRecorder::GetInstance()->OpenFile(libraryFileName + ".bin");
+    }
+    ATLTileCalTBEmShowerTuner::GetInstance()->SetActive(fEmShowerTuning);
     #endif
 
 }
 
+//AddRoulette method
+//
+void ATLTileCalTBRunAction::AddRoulette( const G4String& particle, G4double threshold, G4double survival ) {
+    auto roulette = std::find_if(fRoulette.begin(), fRoulette.end(),
+                                 [&particle](const Roulette& r) { return r.particle == particle; });
+    if ( roulette == fRoulette.end() ) fRoulette.push_back({particle, threshold, survival});
+    else *roulette = {particle, threshold, survival};
+}
+
 void ATLTileCalTBRunAction::EndOfRunAction(const G4Run* /*run*/) {
 
+    //Ntuple rows of the events still in the digitization pipeline
+    //
+    fEventAction->FinishPipeline();
+
+    //Signal time profile of this thread (merged with the other threads by Write)
+    //
+    if ( fTimeProfile ) fEventAction->ReportSignalTimeProfile(fSignalTimeH1ID);
+
     auto analysisManager = G4AnalysisManager::Instance();
     analysisManager->Write();
     analysisManager->CloseFile();
+
+    #ifdef ATLTileCalTB_StepRecord
+    ATLTileCalTBStepRecorder::GetInstance()->CloseFile();
+    #endif
+    #ifdef ATLTileCalTB_FastSim
+    ATLTileCalTBShowerRecorder::GetInstance()->CloseFile();
+
+    //Fitted EM shower parameters (the workers end their run before the master)
+    //
+    if ( fEmShowerTuning ) {
+        ATLTileCalTBEmShowerTuner::GetInstance()->Merge();
+        if ( IsMaster() ) ATLTileCalTBEmShowerTuner::Report();
+    }
+    #endif
     
 }
 
@@ -0,0 +1,381 @@
+//**************************************************
+// \file ATLTileCalTBRunMessenger.cc
+// \brief: implementation of ATLTileCalTBRunMessenger
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBRunMessenger.hh"
+#include "ATLTileCalTBRunAction.hh"
+#include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBEmPresets.hh"
+#ifdef ATLTileCalTB_FastSim
+#include "ATLTileCalTBShowerLibrary.hh"
+#include "ATLTileCalTBEmShower.hh"
+#endif
+
+//Includers from Geant4
+//
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+
+//Includers from C++
+//
+#include <algorithm>
+#include <sstream>
+
+//Constructor and de-constructor
+//
+ATLTileCalTBRunMessenger::ATLTileCalTBRunMessenger( ATLTileCalTBRunAction* runAction )
+    : G4UImessenger(),
+      fRunAction(runAction) {
+
+    fTileTBDir = new G4UIdirectory("/tiletb/");
+    fTileTBDir->SetGuidance("ATLTileCalTB commands");
+
+    fDigiDir = new G4UIdirectory("/tiletb/digi/");
+    fDigiDir->SetGuidance("Digitization mode of the next run");
+
+    fOutputDir = new G4UIdirectory("/tiletb/output/");
+    fOutputDir->SetGuidance("Additional output of the next run");
+
+    fTrackingDir = new G4UIdirectory("/tiletb/tracking/");
+    fTrackingDir->SetGuidance("Tracking mode of the next run");
+
+    fPhysicsDir = new G4UIdirectory("/tiletb/physics/", false);
+    fPhysicsDir->SetGuidance("Physics settings applied at /run/initialize");
+
+    #ifdef ATLTileCalTB_FastSim
+    fLibraryDir = new G4UIdirectory("/tiletb/library/", false);
+    fLibraryDir->SetGuidance("Shower library of the low-energy e+-/gamma (fast simulation)");
+
+    fEmShowerDir = new G4UIdirectory("/tiletb/emShower/", false);
+    fEmShowerDir->SetGuidance("Parameterized showers of the primary e+- (fast simulation of electron calibration runs)");
+    #endif
+
+    fNoiseCmd = new G4UIcmdWithABool("/tiletb/digi/noise", this);
+    fNoiseCmd->SetGuidance("Electronic noise and 2 sigma noise cut on the cell signal (default true)");
+    fNoiseCmd->SetParameterName("noise", true);
+    fNoiseCmd->SetDefaultValue(true);
+    fNoiseCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    G4String presetCandidates;
+    for ( const auto& preset : ATLTileCalTBConstants::digi_presets ) {
+        if ( !presetCandidates.empty() ) presetCandidates += " ";
+        presetCandidates += preset.name;
+    }
+    fDigiPresetCmd = new G4UIcmdWithAString("/tiletb/digi/preset", this);
+    fDigiPresetCmd->SetGuidance("Time binning of the signal (see ATLTileCalTBConstants::digi_presets, default nominal)");
+    fDigiPresetCmd->SetParameterName("preset", false);
+    fDigiPresetCmd->SetCandidates(presetCandidates.c_str());
+    fDigiPresetCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fDigiThreadsCmd = new G4UIcmdWithAnInteger("/tiletb/digi/threads", this);
+    fDigiThreadsCmd->SetGuidance("Digitize the events on this number of threads per worker while it transports");
+    fDigiThreadsCmd->SetGuidance("the next events, 0 digitizes at the end of each event (default 0)");
+    fDigiThreadsCmd->SetParameterName("threads", false);
+    fDigiThreadsCmd->SetRange("threads>=0");
+    fDigiThreadsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fDigiVariantsCmd = new G4UIcmdWithABool("/tiletb/digi/variants", this);
+    fDigiVariantsCmd->SetGuidance("Also digitize the hits with the variants of ATLTileCalTBConstants::digi_variants,");
+    fDigiVariantsCmd->SetGuidance("written to the Sdep_<name> and SdepSum_<name> columns (default false)");
+    fDigiVariantsCmd->SetParameterName("variants", true);
+    fDigiVariantsCmd->SetDefaultValue(true);
+    fDigiVariantsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fPulseOutputCmd = new G4UIcmdWithABool("/tiletb/output/pulses", this);
+    fPulseOutputCmd->SetGuidance("Write the PMT pulses of every cell to ATLTileCalTBpulse_Run<run>/ (slow, default false)");
+    fPulseOutputCmd->SetParameterName("pulses", true);
+    fPulseOutputCmd->SetDefaultValue(true);
+    fPulseOutputCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fLeakAnalysisCmd = new G4UIcmdWithABool("/tiletb/output/leakage", this);
+    fLeakAnalysisCmd->SetGuidance("Fill the Spectrum ntuple with the leakage spectrum analysis (default false)");
+    fLeakAnalysisCmd->SetParameterName("leakage", true);
+    fLeakAnalysisCmd->SetDefaultValue(true);
+    fLeakAnalysisCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fTimeProfileCmd = new G4UIcmdWithABool("/tiletb/output/timeProfile", this);
+    fTimeProfileCmd->SetGuidance("Fill the SignalTime histogram and print the late signal fractions (default false)");
+    fTimeProfileCmd->SetParameterName("timeProfile", true);
+    fTimeProfileCmd->SetDefaultValue(true);
+    fTimeProfileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fSampledReadoutCmd = new G4UIcmdWithABool("/tiletb/output/samples", this);
+    fSampledReadoutCmd->SetGuidance("Fill the Samples (7 samples every 25 ns per PMT), OFAmplitude and OFTime (ns)");
+    fSampledReadoutCmd->SetGuidance("columns with the optimal filter reconstruction of the samples (default false)");
+    fSampledReadoutCmd->SetParameterName("samples", true);
+    fSampledReadoutCmd->SetDefaultValue(true);
+    fSampledReadoutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fCellOutputCmd = new G4UIcmdWithABool("/tiletb/output/cells", this);
+    fCellOutputCmd->SetGuidance("Fill the Edep and Sdep cell vectors, if false only the sums and the topological");
+    fCellOutputCmd->SetGuidance("clusters of the event are written (default true)");
+    fCellOutputCmd->SetParameterName("cells", true);
+    fCellOutputCmd->SetDefaultValue(true);
+    fCellOutputCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fTimeCutCmd = new G4UIcmdWithABool("/tiletb/tracking/timeCut", this);
+    fTimeCutCmd->SetGuidance("Kill the tracks after the time window of the signal plus a margin, their kinetic");
+    fTimeCutCmd->SetGuidance("energy is written to ELate (default true)");
+    fTimeCutCmd->SetParameterName("timeCut", true);
+    fTimeCutCmd->SetDefaultValue(true);
+    fTimeCutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fRouletteCmd = new G4UIcommand("/tiletb/tracking/roulette", this);
+    fRouletteCmd->SetGuidance("Russian roulette on the secondaries of a particle below a kinetic energy threshold,");
+    fRouletteCmd->SetGuidance("the survivors are weighted by 1/survival (replaces the setting of the same particle)");
+    auto rouletteParticle = new G4UIparameter("particle", 's', false);
+    fRouletteCmd->SetParameter(rouletteParticle);
+    auto rouletteThreshold = new G4UIparameter("threshold", 'd', false);
+    rouletteThreshold->SetParameterRange("threshold>0.");
+    fRouletteCmd->SetParameter(rouletteThreshold);
+    auto rouletteUnit = new G4UIparameter("unit", 's', true);
+    rouletteUnit->SetDefaultValue("MeV");
+    rouletteUnit->SetParameterCandidates(G4UIcommand::UnitsList(G4UIcommand::CategoryOf("MeV").c_str()).c_str());
+    fRouletteCmd->SetParameter(rouletteUnit);
+    auto rouletteSurvival = new G4UIparameter("survival", 'd', true);
+    rouletteSurvival->SetParameterRange("survival>0. && survival<=1.");
+    rouletteSurvival->SetDefaultValue("0.5");
+    fRouletteCmd->SetParameter(rouletteSurvival);
+    fRouletteCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fClearRouletteCmd = new G4UIcmdWithoutParameter("/tiletb/tracking/clearRoulette", this);
+    fClearRouletteCmd->SetGuidance("No Russian roulette on any particle (default)");
+    fClearRouletteCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fNonInteractingCmd = new G4UIcmdWithAString("/tiletb/tracking/nonInteracting", this);
+    fNonInteractingCmd->SetGuidance("Kill a particle at creation and write its kinetic energy to ELeak, as if it left");
+    fNonInteractingCmd->SetGuidance("the world without interacting (default the neutrinos)");
+    fNonInteractingCmd->SetParameterName("particle", false);
+    fNonInteractingCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fClearNonInteractingCmd = new G4UIcmdWithoutParameter("/tiletb/tracking/clearNonInteracting", this);
+    fClearNonInteractingCmd->SetGuidance("Transport all the particles, including the neutrinos");
+    fClearNonInteractingCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    G4String emPresetCandidates;
+    for ( const auto& name : ATLTileCalTBEmPresets::GetNames() ) {
+        if ( !emPresetCandidates.empty() ) emPresetCandidates += " ";
+        emPresetCandidates += name;
+    }
+    fEmPresetCmd = new G4UIcmdWithAString("/tiletb/physics/emPreset", this);
+    fEmPresetCmd->SetGuidance("Apply a preset of EM parameters on top of the physics list, same as ATLTileCalTB -e");
+    fEmPresetCmd->SetGuidance("(see ATLTileCalTBEmPresets, default keeps the physics list settings)");
+    fEmPresetCmd->SetParameterName("preset", false);
+    fEmPresetCmd->SetCandidates(emPresetCandidates.c_str());
+    fEmPresetCmd->AvailableForStates(G4State_PreInit);
+    fEmPresetCmd->SetToBeBroadcasted(false);
+
+    #ifdef ATLTileCalTB_FastSim
+    fLibraryLoadCmd = new G4UIcmdWithAString("/tiletb/library/load", this);
+    fLibraryLoadCmd->SetGuidance("Add the entries of a shower library file, the e+-/gamma in the periods with a kinetic");
+    fLibraryLoadCmd->SetGuidance("energy in the library range are replaced by an entry (can be repeated)");
+    fLibraryLoadCmd->SetParameterName("fileName", false);
+    fLibraryLoadCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fLibraryLoadCmd->SetToBeBroadcasted(false);
+
+    fLibraryClearCmd = new G4UIcmdWithoutParameter("/tiletb/library/clear", this);
+    fLibraryClearCmd->SetGuidance("Remove all the entries of the shower library, no particle is replaced (default)");
+    fLibraryClearCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fLibraryClearCmd->SetToBeBroadcasted(false);
+
+    fLibraryMaxEnergyCmd = new G4UIcmdWithADoubleAndUnit("/tiletb/library/maxEnergy", this);
+    fLibraryMaxEnergyCmd->SetGuidance("Maximum kinetic energy of the particles replaced (or recorded) by the shower library");
+    fLibraryMaxEnergyCmd->SetGuidance("(default and upper limit 1 GeV)");
+    fLibraryMaxEnergyCmd->SetParameterName("maxEnergy", false);
+    fLibraryMaxEnergyCmd->SetRange("maxEnergy>0.");
+    fLibraryMaxEnergyCmd->SetUnitCategory("Energy");
+    fLibraryMaxEnergyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fLibraryMaxEnergyCmd->SetToBeBroadcasted(false);
+
+    fLibraryGenerateCmd = new G4UIcmdWithAString("/tiletb/library/generate", this);
+    fLibraryGenerateCmd->SetGuidance("Generation mode: write the sub-showers of the e+-/gamma in the library range to");
+    fLibraryGenerateCmd->SetGuidance("<fileName>_Run<run>[_t<thread>].bin instead of replacing them, no file name disables it");
+    fLibraryGenerateCmd->SetParameterName("fileName", true);
+    fLibraryGenerateCmd->SetDefaultValue("");
+    fLibraryGenerateCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fEmShowerEnableCmd = new G4UIcmdWithABool("/tiletb/emShower/enable", this);
+    fEmShowerEnableCmd->SetGuidance("Replace the showers of the primary e+- above 1 GeV entering a period by parameterized");
+    fEmShowerEnableCmd->SetGuidance("showers (default false)");
+    fEmShowerEnableCmd->SetParameterName("enable", true);
+    fEmShowerEnableCmd->SetDefaultValue(true);
+    fEmShowerEnableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fEmShowerEnableCmd->SetToBeBroadcasted(false);
+
+    fEmShowerParametersCmd = new G4UIcommand("/tiletb/emShower/parameters", this);
+    fEmShowerParametersCmd->SetGuidance("Profile of the parameterized showers, linear in x = ln(E/GeV): mean depth depth0 + depth1 x (mm),");
+    fEmShowerParametersCmd->SetGuidance("gamma shape shape0 + shape1 x, median radius radius0 + radius1 x (mm) and scintillator");
+    fEmShowerParametersCmd->SetGuidance("sampling fraction (as printed at the end of a tuning run)");
+    for ( const char* name : { "depth0", "depth1", "shape0", "shape1", "radius0", "radius1", "samplingFraction" } ) {
+        fEmShowerParametersCmd->SetParameter(new G4UIparameter(name, 'd', false));
+    }
+    fEmShowerParametersCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fEmShowerParametersCmd->SetToBeBroadcasted(false);
+
+    fEmShowerTuneCmd = new G4UIcmdWithABool("/tiletb/emShower/tune", this);
+    fEmShowerTuneCmd->SetGuidance("Tuning mode: fully simulate the showers of the primary e+- and print the parameters");
+    fEmShowerTuneCmd->SetGuidance("fitted to them at the end of the run (default false)");
+    fEmShowerTuneCmd->SetParameterName("tune", true);
+    fEmShowerTuneCmd->SetDefaultValue(true);
+    fEmShowerTuneCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    #endif
+
+}
+
+ATLTileCalTBRunMessenger::~ATLTileCalTBRunMessenger() {
+    #ifdef ATLTileCalTB_FastSim
+    delete fEmShowerTuneCmd;
+    delete fEmShowerParametersCmd;
+    delete fEmShowerEnableCmd;
+    delete fLibraryGenerateCmd;
+    delete fLibraryMaxEnergyCmd;
+    delete fLibraryClearCmd;
+    delete fLibraryLoadCmd;
+    delete fEmShowerDir;
+    delete fLibraryDir;
+    #endif
+    delete fEmPresetCmd;
+    delete fClearNonInteractingCmd;
+    delete fNonInteractingCmd;
+    delete fClearRouletteCmd;
+    delete fRouletteCmd;
+    delete fTimeCutCmd;
+    delete fCellOutputCmd;
+    delete fSampledReadoutCmd;
+    delete fTimeProfileCmd;
+    delete fLeakAnalysisCmd;
+    delete fPulseOutputCmd;
+    delete fDigiVariantsCmd;
+    delete fDigiThreadsCmd;
+    delete fDigiPresetCmd;
+    delete fNoiseCmd;
+    delete fPhysicsDir;
+    delete fTrackingDir;
+    delete fOutputDir;
+    delete fDigiDir;
+    delete fTileTBDir;
+}
+
+//SetNewValue method
+//
+void ATLTileCalTBRunMessenger::SetNewValue( G4UIcommand* command, G4String newValue ) {
+    if ( command == fNoiseCmd ) {
+        fRunAction->SetNoise(G4UIcmdWithABool::GetNewBoolValue(newValue));
+    }
+    else if ( command == fDigiPresetCmd ) {
+        fRunAction->SetDigiPreset(newValue);
+    }
+    else if ( command == fDigiThreadsCmd ) {
+        fRunAction->SetDigiThreads(G4UIcmdWithAnInteger::GetNewIntValue(newValue));
+    }
+    else if ( command == fDigiVariantsCmd ) {
+        fRunAction->SetDigiVariants(G4UIcmdWithABool::GetNewBoolValue(newValue));
+    }
+    else if ( command == fPulseOutputCmd ) {
+        fRunAction->SetPulseOutput(G4UIcmdWithABool::GetNewBoolValue(newValue));
+    }
+    else if ( command == fLeakAnalysisCmd ) {
+        fRunAction->SetLeakAnalysis(G4UIcmdWithABool::GetNewBoolValue(newValue));
+    }
+    else if ( command == fTimeProfileCmd ) {
+        fRunAction->SetTimeProfile(G4UIcmdWithABool::GetNewBoolValue(newValue));
+    }
+    else if ( command == fSampledReadoutCmd ) {
+        fRunAction->SetSampledReadout(G4UIcmdWithABool::GetNewBoolValue(newValue));
+    }
+    else if ( command == fCellOutputCmd ) {
+        fRunAction->SetCellOutput(G4UIcmdWithABool::GetNewBoolValue(newValue));
+    }
+    else if ( command == fTimeCutCmd ) {
+        fRunAction->SetTimeCut(G4UIcmdWithABool::GetNewBoolValue(newValue));
+    }
+    else if ( command == fRouletteCmd ) {
+        G4String particle, unit;
+        G4double threshold = 0.;
+        G4double survival = 1.;
+        std::istringstream is(newValue);
+        is >> particle >> threshold >> unit >> survival;
+        fRunAction->AddRoulette(particle, threshold * G4UIcommand::ValueOf(unit.c_str()), survival);
+    }
+    else if ( command == fClearRouletteCmd ) {
+        fRunAction->ClearRoulette();
+    }
+    else if ( command == fNonInteractingCmd ) {
+        fRunAction->AddNonInteracting(newValue);
+    }
+    else if ( command == fClearNonInteractingCmd ) {
+        fRunAction->ClearNonInteracting();
+    }
+    else if ( command == fEmPresetCmd ) {
+        ATLTileCalTBEmPresets::Apply(newValue);  // names are checked by the candidates
+    }
+    #ifdef ATLTileCalTB_FastSim
+    else if ( command == fLibraryLoadCmd ) {
+        auto library = ATLTileCalTBShowerLibrary::GetInstance();
+        if ( library->Load(newValue) ) G4cout << "Shower library: " << library->GetNumberOfEntries() << " entries" << G4endl;
+    }
+    else if ( command == fLibraryClearCmd ) {
+        ATLTileCalTBShowerLibrary::GetInstance()->Clear();
+    }
+    else if ( command == fLibraryMaxEnergyCmd ) {
+        ATLTileCalTBShowerLibrary::GetInstance()->SetMaxEnergy(
+            std::min(fLibraryMaxEnergyCmd->GetNewDoubleValue(newValue), ATLTileCalTBConstants::shower_library_max_energy));
+    }
+    else if ( command == fLibraryGenerateCmd ) {
+        fRunAction->SetLibraryFile(newValue);
+    }
+    else if ( command == fEmShowerEnableCmd ) {
+        ATLTileCalTBEmShower::GetInstance()->SetEnabled(G4UIcmdWithABool::GetNewBoolValue(newValue));
+    }
+    else if ( command == fEmShowerParametersCmd ) {
+        ATLTileCalTBEmShower::Parameters parameters{};
+        std::istringstream is(newValue);
+        is >> parameters.depth0 >> parameters.depth1 >> parameters.shape0 >> parameters.shape1
+           >> parameters.radius0 >> parameters.radius1 >> parameters.sampling_fraction;
+        ATLTileCalTBEmShower::GetInstance()->SetParameters(parameters);
+    }
+    else if ( command == fEmShowerTuneCmd ) {
+        fRunAction->SetEmShowerTuning(G4UIcmdWithABool::GetNewBoolValue(newValue));
+    }
+    #endif
+}
+
+//GetCurrentValue method
+//
+G4String ATLTileCalTBRunMessenger::GetCurrentValue( G4UIcommand* command ) {
+    if ( command == fNoiseCmd ) return G4UIcommand::ConvertToString(fRunAction->GetNoise());
+    if ( command == fPulseOutputCmd ) return G4UIcommand::ConvertToString(fRunAction->GetPulseOutput());
+    if ( command == fDigiPresetCmd ) return fRunAction->GetDigiPreset();
+    if ( command == fDigiThreadsCmd ) return G4UIcommand::ConvertToString(fRunAction->GetDigiThreads());
+    if ( command == fDigiVariantsCmd ) return G4UIcommand::ConvertToString(fRunAction->GetDigiVariants());
+    if ( command == fLeakAnalysisCmd ) return G4UIcommand::ConvertToString(fRunAction->GetLeakAnalysis());
+    if ( command == fTimeProfileCmd ) return G4UIcommand::ConvertToString(fRunAction->GetTimeProfile());
+    if ( command == fSampledReadoutCmd ) return G4UIcommand::ConvertToString(fRunAction->GetSampledReadout());
+    if ( command == fCellOutputCmd ) return G4UIcommand::ConvertToString(fRunAction->GetCellOutput());
+    if ( command == fTimeCutCmd ) return G4UIcommand::ConvertToString(fRunAction->GetTimeCut());
+    if ( command == fEmPresetCmd ) return ATLTileCalTBEmPresets::GetActive();
+    #ifdef ATLTileCalTB_FastSim
+    if ( command == fLibraryMaxEnergyCmd ) {
+        return fLibraryMaxEnergyCmd->ConvertToString(ATLTileCalTBShowerLibrary::GetInstance()->GetMaxEnergy(), "MeV");
+    }
+    if ( command == fLibraryGenerateCmd ) return fRunAction->GetLibraryFile();
+    if ( command == fEmShowerEnableCmd ) return G4UIcommand::ConvertToString(ATLTileCalTBEmShower::GetInstance()->IsEnabled());
+    if ( command == fEmShowerTuneCmd ) return G4UIcommand::ConvertToString(fRunAction->GetEmShowerTuning());
+    #endif
+    return "";
+}
+
+//**************************************************
@@ -0,0 +1,307 @@
+//**************************************************
+// \file ATLTileCalTBShowerLibrary.cc
+// \brief: implementation of ATLTileCalTBShowerLibrary
+//         classes
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBShowerLibrary.hh"
+#include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBGeometry.hh"
+
+//Includers from Geant4
+//
+#include "G4Exception.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "G4Gamma.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+//Includers from C++
+//
+#include <algorithm>
+#include <cmath>
+
+//IsValidHeader method
+//
+G4bool ATLTileCalTBShowerLibraryFile::IsValidHeader( const ATLTileCalTBShowerLibraryHeader& header ) {
+    return std::equal(std::begin(magic), std::end(magic), std::begin(header.magic)) &&
+           header.version == version &&
+           header.spotSize == sizeof(ATLTileCalTBShowerLibrarySpot);
+}
+
+//GetParticleClass method
+//
+ATLTileCalTBShowerLibraryFile::ParticleClass ATLTileCalTBShowerLibraryFile::GetParticleClass( const G4Track* track ) {
+    const auto particle = track->GetParticleDefinition();
+    if ( particle == G4Electron::Definition() ) return ParticleClass::ELECTRON;
+    if ( particle == G4Positron::Definition() ) return ParticleClass::POSITRON;
+    if ( particle == G4Gamma::Definition() ) return ParticleClass::GAMMA;
+    return ParticleClass::NONE;
+}
+
+//GetEnergyBin method
+//
+std::size_t ATLTileCalTBShowerLibraryFile::GetEnergyBin( G4double energy ) {
+    using namespace ATLTileCalTBConstants;
+    if ( energy < shower_library_min_energy || energy >= shower_library_max_energy ) return no_bin;
+    const G4double fraction = std::log(energy / shower_library_min_energy) /
+                              std::log(shower_library_max_energy / shower_library_min_energy);
+    return std::min(static_cast<std::size_t>(fraction * shower_library_energy_bins), shower_library_energy_bins - 1);
+}
+
+//GetBin method
+//
+std::size_t ATLTileCalTBShowerLibraryFile::GetBin( ParticleClass particleClass, std::size_t row, std::size_t phaseBin,
+                                                   std::size_t energyBin ) {
+    using namespace ATLTileCalTBConstants;
+    if ( particleClass == ParticleClass::NONE || row >= ATLTileCalTBGeometry::CellLUT::no_of_rows ||
+         phaseBin >= shower_library_phase_bins || energyBin >= shower_library_energy_bins ) return no_bin;
+    return ( ( static_cast<std::size_t>(particleClass) * ATLTileCalTBGeometry::CellLUT::no_of_rows + row )
+             * shower_library_phase_bins + phaseBin ) * shower_library_energy_bins + energyBin;
+}
+
+//GetNumberOfBins method
+//
+std::size_t ATLTileCalTBShowerLibraryFile::GetNumberOfBins() {
+    using namespace ATLTileCalTBConstants;
+    return no_of_particle_classes * ATLTileCalTBGeometry::CellLUT::no_of_rows * shower_library_phase_bins
+           * shower_library_energy_bins;
+}
+
+//Constructor
+//
+ATLTileCalTBShowerLibrary::ATLTileCalTBShowerLibrary()
+    : fEntries(),
+      fSpotOffsets(),
+      fSpots(),
+      fBins(ATLTileCalTBShowerLibraryFile::GetNumberOfBins()),
+      fMaxEnergy(ATLTileCalTBConstants::shower_library_max_energy) {
+}
+
+//Load method
+//
+G4bool ATLTileCalTBShowerLibrary::Load( const G4String& fileName ) {
+
+    std::ifstream file(fileName, std::ios::binary);
+    ATLTileCalTBShowerLibraryHeader header{};
+    if ( !file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+         !ATLTileCalTBShowerLibraryFile::IsValidHeader(header) ) {
+        G4ExceptionDescription msg;
+        msg << "Cannot read shower library file " << fileName;
+        G4Exception("ATLTileCalTBShowerLibrary::Load()", "MyCode0019", JustWarning, msg);
+        return false;
+    }
+
+    using namespace ATLTileCalTBShowerLibraryFile;
+    ATLTileCalTBShowerLibraryEntry entry{};
+    while ( file.read(reinterpret_cast<char*>(&entry), sizeof(entry)) ) {
+        const std::size_t offset = fSpots.size();
+        fSpots.resize(offset + entry.nSpots);
+        if ( !file.read(reinterpret_cast<char*>(fSpots.data() + offset), entry.nSpots * sizeof(ATLTileCalTBShowerLibrarySpot)) ) {
+            fSpots.resize(offset);
+            break;
+        }
+        const std::size_t bin = GetBin(static_cast<ParticleClass>(entry.particleClass), entry.row, entry.phaseBin,
+                                       GetEnergyBin(entry.energy * MeV));
+        if ( bin == no_bin ) {
+            fSpots.resize(offset);
+            continue;
+        }
+        fBins[bin].push_back(static_cast<std::uint32_t>(fEntries.size()));
+        fEntries.push_back(entry);
+        fSpotOffsets.push_back(offset);
+    }
+    return true;
+
+}
+
+//Clear method
+//
+void ATLTileCalTBShowerLibrary::Clear() {
+    fEntries.clear();
+    fSpotOffsets.clear();
+    fSpots.clear();
+    for ( auto& bin : fBins ) bin.clear();
+}
+
+//GetSample method
+//
+ATLTileCalTBShowerLibrary::Sample ATLTileCalTBShowerLibrary::GetSample( ATLTileCalTBShowerLibraryFile::ParticleClass particleClass,
+                                                                        std::size_t row, std::size_t phaseBin, G4double energy ) const {
+
+    using namespace ATLTileCalTBShowerLibraryFile;
+    const std::size_t energyBin = GetEnergyBin(energy);
+    if ( energyBin == no_bin ) return Sample{ nullptr, nullptr };
+
+    //Closest energy bin with entries, the lower one first
+    //
+    for ( std::size_t distance = 0; distance < ATLTileCalTBConstants::shower_library_energy_bins; ++distance ) {
+        for ( const std::size_t candidate : { energyBin - distance, energyBin + distance } ) {
+            const std::size_t bin = GetBin(particleClass, row, phaseBin, candidate);
+            if ( bin == no_bin || fBins[bin].empty() ) continue;
+            const auto& entries = fBins[bin];
+            const std::size_t n = std::min(static_cast<std::size_t>(G4UniformRand() * entries.size()), entries.size() - 1);
+            const std::size_t index = entries[n];
+            return Sample{ &fEntries[index], fSpots.data() + fSpotOffsets[index] };
+        }
+    }
+    return Sample{ nullptr, nullptr };
+
+}
+
+//OpenFile method
+//
+void ATLTileCalTBShowerRecorder::OpenFile( const G4String& fileName ) {
+
+    fFile.open(fileName, std::ios::binary | std::ios::trunc);
+    if ( ! fFile ) {
+        G4ExceptionDescription msg;
+        msg << "Cannot open shower library file " << fileName;
+        G4Exception("ATLTileCalTBShowerRecorder::OpenFile()",
+        "MyCode0020", FatalException, msg);
+        return;
+    }
+
+    ATLTileCalTBShowerLibraryHeader header{};
+    std::copy(std::begin(ATLTileCalTBShowerLibraryFile::magic), std::end(ATLTileCalTBShowerLibraryFile::magic), header.magic);
+    header.version = ATLTileCalTBShowerLibraryFile::version;
+    header.spotSize = sizeof(ATLTileCalTBShowerLibrarySpot);
+    fFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fBinEntries.assign(ATLTileCalTBShowerLibraryFile::GetNumberOfBins(), 0);
+
+}
+
+//CloseFile method
+//
+void ATLTileCalTBShowerRecorder::CloseFile() {
+    fRoots.clear();
+    fRootOfTrack.clear();
+    if ( fFile.is_open() ) fFile.close();
+}
+
+//AddRoot method
+//
+G4bool ATLTileCalTBShowerRecorder::AddRoot( const G4Track* track, ATLTileCalTBShowerLibraryFile::ParticleClass particleClass,
+                                            const G4VPhysicalVolume* moduleVolume, G4int period, G4int row, std::size_t phaseBin,
+                                            G4double yLocal ) {
+
+    const G4double energy = track->GetKineticEnergy();
+    const std::size_t bin = ATLTileCalTBShowerLibraryFile::GetBin(particleClass, row, phaseBin,
+                                                                  ATLTileCalTBShowerLibraryFile::GetEnergyBin(energy));
+    if ( bin == ATLTileCalTBShowerLibraryFile::no_bin || fBinEntries[bin] >= ATLTileCalTBConstants::shower_library_max_entries ) {
+        return false;
+    }
+    ++fBinEntries[bin];
+
+    Root root{};
+    root.entry = ATLTileCalTBShowerLibraryEntry{ static_cast<std::uint8_t>(particleClass), static_cast<std::uint8_t>(row),
+                                                 static_cast<std::uint8_t>(phaseBin), 0, static_cast<G4float>(energy / MeV), 0.f, 0.f, 0 };
+    root.moduleVolume = moduleVolume;
+    root.period = period;
+    root.row = row;
+    root.yLocal = yLocal;
+    root.time = track->GetGlobalTime();
+    root.weight = track->GetWeight();
+    fRootOfTrack[track->GetTrackID()] = fRoots.size();
+    fRoots.push_back(std::move(root));
+    return true;
+
+}
+
+//IsFollowed method
+//
+G4bool ATLTileCalTBShowerRecorder::IsFollowed( const G4Track* track ) const {
+    return fRootOfTrack.count(track->GetTrackID()) > 0;
+}
+
+//AddTrack method
+//
+void ATLTileCalTBShowerRecorder::AddTrack( const G4Track* track ) {
+    if ( fRoots.empty() ) return;
+    const auto parent = fRootOfTrack.find(track->GetParentID());
+    if ( parent != fRootOfTrack.end() ) fRootOfTrack[track->GetTrackID()] = parent->second;
+}
+
+//FindRoot method
+//
+ATLTileCalTBShowerRecorder::Root* ATLTileCalTBShowerRecorder::FindRoot( const G4Track* track ) {
+    if ( fRoots.empty() ) return nullptr;
+    const auto root = fRootOfTrack.find(track->GetTrackID());
+    return ( root != fRootOfTrack.end() ) ? &fRoots[root->second] : nullptr;
+}
+
+//AddDeposit method
+//
+void ATLTileCalTBShowerRecorder::AddDeposit( const G4Track* track, const G4VPhysicalVolume* moduleVolume, G4int period, G4int row,
+                                             G4double time, G4double yLocal, G4double zLocal, G4double edep, G4double visibleEnergy ) {
+
+    auto root = FindRoot(track);
+    //Deposits in other modules are not part of the entry
+    if ( !root || root->moduleVolume != moduleVolume ) return;
+
+    const auto dPeriod = static_cast<std::int16_t>(period - root->period);
+    const auto dRow = static_cast<std::int16_t>(row - root->row);
+    const std::uint32_t key = ( static_cast<std::uint32_t>(static_cast<std::uint16_t>(dPeriod)) << 16 ) |
+                              static_cast<std::uint16_t>(dRow);
+    auto& spot = root->spots.try_emplace(key, ATLTileCalTBShowerLibrarySpot{ dPeriod, dRow, 0.f, 0.f, 0.f, 0.f, 0.f }).first->second;
+    const G4double energy = edep / root->weight / MeV;
+    spot.dy += static_cast<G4float>(( yLocal - root->yLocal ) / mm * energy);
+    spot.zLocal += static_cast<G4float>(zLocal / mm * energy);
+    spot.dt += static_cast<G4float>(( time - root->time ) / ns * energy);
+    spot.edep += static_cast<G4float>(energy);
+    spot.visibleEnergy += static_cast<G4float>(visibleEnergy / root->weight / MeV);
+
+}
+
+//AddEcal method
+//
+void ATLTileCalTBShowerRecorder::AddEcal( const G4Track* track, G4double edep ) {
+    auto root = FindRoot(track);
+    if ( root ) root->entry.eCal += static_cast<G4float>(edep / root->weight / MeV);
+}
+
+//AddLeak method
+//The tracks killed at creation are not followed yet, their parent is
+//
+void ATLTileCalTBShowerRecorder::AddLeak( const G4Track* track, G4double energy ) {
+    if ( fRoots.empty() ) return;
+    auto root = fRootOfTrack.find(track->GetTrackID());
+    if ( root == fRootOfTrack.end() ) root = fRootOfTrack.find(track->GetParentID());
+    if ( root != fRootOfTrack.end() ) fRoots[root->second].entry.eLeak += static_cast<G4float>(energy / fRoots[root->second].weight / MeV);
+}
+
+//WriteEvent method
+//
+void ATLTileCalTBShowerRecorder::WriteEvent() {
+
+    if ( fFile.is_open() ) {
+        std::vector<ATLTileCalTBShowerLibrarySpot> spots;
+        for ( auto& root : fRoots ) {
+            spots.clear();
+            for ( const auto& [key, spot] : root.spots ) {
+                if ( spot.edep <= 0.f ) continue;
+                auto mean = spot;
+                mean.dy /= spot.edep;
+                mean.zLocal /= spot.edep;
+                mean.dt /= spot.edep;
+                spots.push_back(mean);
+            }
+            root.entry.nSpots = static_cast<std::uint32_t>(spots.size());
+            fFile.write(reinterpret_cast<const char*>(&root.entry), sizeof(root.entry));
+            fFile.write(reinterpret_cast<const char*>(spots.data()), spots.size() * sizeof(ATLTileCalTBShowerLibrarySpot));
+        }
+    }
+    fRoots.clear();
+    fRootOfTrack.clear();
+
+}
+
+//**************************************************
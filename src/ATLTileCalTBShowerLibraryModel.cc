@@ -0,0 +1,152 @@
+//**************************************************
+// \file ATLTileCalTBShowerLibraryModel.cc
+// \brief: implementation of ATLTileCalTBShowerLibraryModel
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBShowerLibraryModel.hh"
+#include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBEventAction.hh"
+#include "ATLTileCalTBSensDet.hh"
+
+//Includers from Geant4
+//
+#include "G4EventManager.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4TouchableHandle.hh"
+#include "G4NavigationHistory.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "G4Gamma.hh"
+#include "G4SystemOfUnits.hh"
+
+//Includers from C++
+//
+#include <algorithm>
+
+//Constructor and de-constructor
+//
+ATLTileCalTBShowerLibraryModel::ATLTileCalTBShowerLibraryModel( const G4String& name, G4Region* region, ATLTileCalTBSensDet* sensDet )
+    : G4VFastSimulationModel(name, region),
+      fSensDet(sensDet),
+      fPeriodLayouts(),
+      fModuleVolume(nullptr),
+      fPeriodLayout(nullptr),
+      fPeriod(0),
+      fRow(0),
+      fYLocal(0.),
+      fSample{ nullptr, nullptr } {
+}
+
+ATLTileCalTBShowerLibraryModel::~ATLTileCalTBShowerLibraryModel() {}
+
+//IsApplicable method
+//
+G4bool ATLTileCalTBShowerLibraryModel::IsApplicable( const G4ParticleDefinition& particle ) {
+    return &particle == G4Electron::Definition() || &particle == G4Positron::Definition() || &particle == G4Gamma::Definition();
+}
+
+//ModelTrigger method
+//
+G4bool ATLTileCalTBShowerLibraryModel::ModelTrigger( const G4FastTrack& fastTrack ) {
+
+    auto library = ATLTileCalTBShowerLibrary::GetInstance();
+    auto showerRecorder = ATLTileCalTBShowerRecorder::GetInstance();
+    const G4bool generation = showerRecorder->IsOpen();
+    if ( !generation && library->IsEmpty() ) return false;
+
+    //Particles in the energy range of the library entering a period (the model
+    //is asked at every step, the tracks created or slowed down inside a period
+    //are simulated until they enter the next one)
+    //
+    const auto track = fastTrack.GetPrimaryTrack();
+    const G4double energy = track->GetKineticEnergy();
+    if ( energy < ATLTileCalTBConstants::shower_library_min_energy || energy >= library->GetMaxEnergy() ) return false;
+    if ( track->GetStep()->GetPreStepPoint()->GetStepStatus() != fGeomBoundary ) return false;
+    const auto periodVolume = track->GetVolume()->GetLogicalVolume();
+    const auto layout = fPeriodLayouts.Find( periodVolume );
+    if ( !layout ) return false;
+    if ( generation && showerRecorder->IsFollowed( track ) ) return false;
+
+    //On the surface of the period, not coming from one of its daughters
+    //
+    const auto& handle = track->GetTouchableHandle();
+    const auto position = handle->GetHistory()->GetTopTransform().TransformPoint( track->GetPosition() );
+    if ( periodVolume->GetSolid()->Inside( position ) != kSurface ) return false;
+
+    //Module (depth 3 of the period touchable), its periods must be parsable
+    //
+    const auto moduleVolume = handle->GetVolume(3);
+    if ( fSensDet->GetNumberOfPeriods( moduleVolume ) == 0 ) return false;
+
+    //Row of the closest tile and phase along the period axis from its tile
+    //
+    const auto& tile = layout->FindClosestTile( position.z() );
+    const G4double phase = layout->GetPhase( tile, position.x() );
+    const std::size_t phaseBin = std::min( static_cast<std::size_t>( phase * ATLTileCalTBConstants::shower_library_phase_bins ),
+                                           ATLTileCalTBConstants::shower_library_phase_bins - 1 );
+    const auto particleClass = ATLTileCalTBShowerLibraryFile::GetParticleClass( track );
+
+    //Generation mode: start a new entry and simulate the particle
+    //
+    if ( generation ) {
+        showerRecorder->AddRoot( track, particleClass, moduleVolume, handle->GetVolume(0)->GetCopyNo(), tile.row, phaseBin, position.y() );
+        return false;
+    }
+
+    fSample = library->GetSample( particleClass, tile.row, phaseBin, energy );
+    if ( !fSample.entry ) return false;
+    fModuleVolume = moduleVolume;
+    fPeriodLayout = layout;
+    fPeriod = handle->GetVolume(0)->GetCopyNo();
+    fRow = tile.row;
+    fYLocal = position.y();
+    return true;
+
+}
+
+//DoIt method
+//
+void ATLTileCalTBShowerLibraryModel::DoIt( const G4FastTrack& fastTrack, G4FastStep& fastStep ) {
+
+    //Deposits of the entry scaled to the energy of the particle, the positions
+    //are kept inside the scintillator of the row in the start period. The visible
+    //energy is scaled as well: Birk's law is not applied again, its saturation is
+    //the one of the entry (closest energy bin with entries)
+    //
+    const auto track = fastTrack.GetPrimaryTrack();
+    const G4double scale = track->GetKineticEnergy() / ( fSample.entry->energy * MeV ) * track->GetWeight();
+    const G4double time = track->GetGlobalTime();
+    for ( std::uint32_t n = 0; n < fSample.entry->nSpots; ++n ) {
+        const auto& spot = fSample.spots[n];
+        const G4int row = fRow + spot.dRow;
+        const auto tile = fPeriodLayout->FindTile( row );
+        if ( !tile ) continue;
+        const G4double yLocal = std::clamp( fYLocal + spot.dy * mm, -tile->yHalf, tile->yHalf );
+        const G4double zLocal = std::clamp( static_cast<G4double>( spot.zLocal ) * mm, -tile->zHalf, tile->zHalf );
+        fSensDet->AddFastDeposit( fModuleVolume, row, fPeriod + spot.dPeriod, time + spot.dt * ns, yLocal, zLocal,
+                                  spot.edep * MeV * scale, spot.visibleEnergy * MeV * scale );
+    }
+
+    //Calo energy (all volumes) and leakage of the entry
+    //
+    auto eventAction = static_cast<ATLTileCalTBEventAction*>( G4EventManager::GetEventManager()->GetUserEventAction() );
+    eventAction->Add( 1, fSample.entry->eCal * MeV * scale );
+    eventAction->Add( 0, fSample.entry->eLeak * MeV * scale );
+
+    fastStep.KillPrimaryTrack();
+    fastStep.ProposePrimaryTrackPathLength( 0. );
+    fastStep.ProposeTotalEnergyDeposited( 0. );
+
+}
+
+//**************************************************
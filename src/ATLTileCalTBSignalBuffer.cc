@@ -0,0 +1,67 @@
+//**************************************************
+// \file ATLTileCalTBSignalBuffer.cc
+// \brief: implementation of ATLTileCalTBSignalBuffer
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBSignalBuffer.hh"
+
+//Includers from Geant4
+//
+#include "G4Exception.hh"
+#include "G4UnitsTable.hh"
+
+//Constructor
+//
+ATLTileCalTBSignalBuffer::ATLTileCalTBSignalBuffer()
+    : fBinTime(ATLTileCalTBConstants::frame_bin_time),
+      fTimeWindow(ATLTileCalTBConstants::frame_time_window),
+      fFrames(ATLTileCalTBConstants::frames),
+      fSdep(ATLTileCalTBGeometry::CellLUT::no_of_cells * fNoOfPMTs * ATLTileCalTBConstants::frames, 0.),
+      fBeginBin(),
+      fEndBin(),
+      fDirtyCells() {
+    fBeginBin.fill(0);
+    fEndBin.fill(0);
+    fDirtyCells.reserve(ATLTileCalTBGeometry::CellLUT::no_of_cells);
+}
+
+//Reset method
+//
+void ATLTileCalTBSignalBuffer::Reset() {
+    for ( auto cellIndex : fDirtyCells ) {
+        auto sdep = fSdep.begin() + cellIndex * fNoOfPMTs * fFrames;
+        for ( std::size_t pmt = 0; pmt < fNoOfPMTs; ++pmt ) {
+            std::fill(sdep + pmt * fFrames + fBeginBin[cellIndex], sdep + pmt * fFrames + fEndBin[cellIndex], 0.);
+        }
+        fBeginBin[cellIndex] = 0;
+        fEndBin[cellIndex] = 0;
+    }
+    fDirtyCells.clear();
+}
+
+//SetLayout method
+//
+void ATLTileCalTBSignalBuffer::SetLayout( G4double binTime, G4double timeWindow ) {
+    const std::size_t frames = ( binTime > 0. && timeWindow > 0. ) ? static_cast<std::size_t>(timeWindow / binTime) : 0;
+    if ( frames == 0 || frames > ATLTileCalTBConstants::frames ) {
+        G4ExceptionDescription msg;
+        msg << "Time binning of " << G4BestUnit(binTime, "Time") << " over " << G4BestUnit(timeWindow, "Time")
+            << " gives " << frames << " frames, allowed are 1 to " << ATLTileCalTBConstants::frames;
+        G4Exception("ATLTileCalTBSignalBuffer::SetLayout()", "MyCode0012", FatalException, msg);
+        return;
+    }
+
+    Reset();
+    fBinTime = binTime;
+    fTimeWindow = timeWindow;
+    fFrames = frames;
+    fSdep.assign(ATLTileCalTBGeometry::CellLUT::no_of_cells * fNoOfPMTs * fFrames, 0.);
+}
+
+//**************************************************
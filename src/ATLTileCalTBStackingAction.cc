@@ -0,0 +1,81 @@
+//**************************************************
+// \file ATLTileCalTBStackingAction.cc
+// \brief: implementation of ATLTileCalTBStackingAction
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBStackingAction.hh"
+#include "ATLTileCalTBEventAction.hh"
+#include "SpectrumAnalyzer.hh"
+#ifdef ATLTileCalTB_FastSim
+#include "ATLTileCalTBShowerLibrary.hh"
+#endif
+
+//Includers from Geant4
+//
+#include "G4Track.hh"
+#include "Randomize.hh"
+
+//Includers from C++
+//
+#include <algorithm>
+
+//Constructor and de-constructor
+//
+ATLTileCalTBStackingAction::ATLTileCalTBStackingAction( ATLTileCalTBEventAction* eventAction )
+    : G4UserStackingAction(),
+      fEventAction(eventAction),
+      fNonInteracting(),
+      fRoulette() {
+}
+
+ATLTileCalTBStackingAction::~ATLTileCalTBStackingAction() {}
+
+//ClassifyNewTrack method
+//
+G4ClassificationOfNewTrack ATLTileCalTBStackingAction::ClassifyNewTrack( const G4Track* aTrack ) {
+
+    //Non-interacting particles leak at any time
+    if ( std::find(fNonInteracting.begin(), fNonInteracting.end(), aTrack->GetDefinition()) != fNonInteracting.end() ) {
+        fEventAction->Add( 0, aTrack->GetKineticEnergy() * aTrack->GetWeight() );
+        if ( auto spectrumAnalyzer = fEventAction->GetSpectrumAnalyzer() ) spectrumAnalyzer->Analyze(aTrack);
+        #ifdef ATLTileCalTB_FastSim
+        auto showerRecorder = ATLTileCalTBShowerRecorder::GetInstance();
+        if ( showerRecorder->IsOpen() ) showerRecorder->AddLeak( aTrack, aTrack->GetKineticEnergy() * aTrack->GetWeight() );
+        #endif
+        return fKill;
+    }
+
+    if ( aTrack->GetGlobalTime() > fEventAction->GetTimeCut() ) {
+        fEventAction->Add( 2, aTrack->GetKineticEnergy() * aTrack->GetWeight() );
+        return fKill;
+    }
+
+    //Russian roulette (never on the primary particle)
+    if ( aTrack->GetParentID() > 0 ) {
+        for ( const auto& roulette : fRoulette ) {
+            if ( aTrack->GetDefinition() != roulette.particle ) continue;
+            if ( aTrack->GetKineticEnergy() >= roulette.threshold ) break;
+            if ( G4UniformRand() >= roulette.survival ) return fKill;
+            //The stacking action only gets a const track, the weight
+            //is set before the track is pushed to the stack
+            const_cast<G4Track*>(aTrack)->SetWeight( aTrack->GetWeight() / roulette.survival );
+            break;
+        }
+    }
+    return fUrgent;
+
+}
+
+//AddRoulette method
+//
+void ATLTileCalTBStackingAction::AddRoulette( const G4ParticleDefinition* particle, G4double threshold, G4double survival ) {
+    fRoulette.push_back({particle, threshold, survival});
+}
+
+//**************************************************
@@ -10,18 +10,39 @@
 //Includers from project files
 //
 #include "ATLTileCalTBStepAction.hh"
-#ifdef ATLTileCalTB_LEAKANALYSIS
 #include "SpectrumAnalyzer.hh"
+#ifdef ATLTileCalTB_FastSim
+#include "ATLTileCalTBShowerLibrary.hh"
+#include "ATLTileCalTBEmShower.hh"
 #endif
 
+//Includers from Geant4
+//
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+
 //Constructor and de-constructor
 //
 ATLTileCalTBStepAction::ATLTileCalTBStepAction(ATLTileCalTBEventAction* EventAction)
     : G4UserSteppingAction(),
-      fEventAction( EventAction ){}
+      fEventAction( EventAction ),
+      fVolumeRoles() {}
 
 ATLTileCalTBStepAction::~ATLTileCalTBStepAction() {}
 
+//BuildVolumeRoles() method
+//
+void ATLTileCalTBStepAction::BuildVolumeRoles() {
+
+    fVolumeRoles.clear();
+    for ( auto volume : *G4LogicalVolumeStore::GetInstance() ) {
+        const std::size_t id = volume->GetInstanceID();
+        if ( id >= fVolumeRoles.size() ) fVolumeRoles.resize( id + 1, ATLTileCalTBGeometry::VolumeRole::ENVELOPE );
+        fVolumeRoles[id] = ATLTileCalTBGeometry::GetVolumeRole( volume->GetName() );
+    }
+
+}
+
 //UserSteppingaction() method
 //
 void ATLTileCalTBStepAction::UserSteppingAction( const G4Step* aStep ) {
@@ -29,20 +50,29 @@ void ATLTileCalTBStepAction::UserSteppingAction( const G4Step* aStep ) {
     //Collect out of world leakage
     //
     if ( !aStep->GetTrack()->GetNextVolume() ){
-        fEventAction->Add( 0, aStep->GetTrack()->GetKineticEnergy() ); 
-        #ifdef ATLTileCalTB_LEAKANALYSIS
-        SpectrumAnalyzer::GetInstance()->Analyze(aStep);
+        fEventAction->Add( 0, aStep->GetTrack()->GetKineticEnergy() * aStep->GetTrack()->GetWeight() );
+        if ( auto spectrumAnalyzer = fEventAction->GetSpectrumAnalyzer() ) spectrumAnalyzer->Analyze(aStep);
+        #ifdef ATLTileCalTB_FastSim
+        auto showerRecorder = ATLTileCalTBShowerRecorder::GetInstance();
+        if ( showerRecorder->IsOpen() ) showerRecorder->AddLeak( aStep->GetTrack(), aStep->GetTrack()->GetKineticEnergy() * aStep->GetTrack()->GetWeight() );
         #endif
     }
 
-    if ( aStep->GetTrack()->GetTouchableHandle()->GetVolume()->GetName() != "CALO::CALO" ||
-         aStep->GetTrack()->GetTouchableHandle()->GetVolume()->GetName() != "Barrel" ) {
- 
-        //Collect calo energy deposition (everything but what goes into CALO::CALO and Barrel) 
-        //Warning: not exact measurement
-        //
-        fEventAction->Add( 1, aStep->GetTotalEnergyDeposit() );
-    
+    //Collect calo energy deposition (absorber, scintillator and passive material,
+    //not the air envelopes, the world and the ancillary detectors)
+    //
+    const G4double edep = aStep->GetTotalEnergyDeposit();
+    if ( edep > 0. ) {
+        const std::size_t id = aStep->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume()->GetInstanceID();
+        if ( id < fVolumeRoles.size() && ATLTileCalTBGeometry::IsCalorimeter( fVolumeRoles[id] ) ) {
+            fEventAction->Add( 1, edep * aStep->GetTrack()->GetWeight() );
+            #ifdef ATLTileCalTB_FastSim
+            auto showerRecorder = ATLTileCalTBShowerRecorder::GetInstance();
+            if ( showerRecorder->IsOpen() ) showerRecorder->AddEcal( aStep->GetTrack(), edep * aStep->GetTrack()->GetWeight() );
+            auto emShowerTuner = ATLTileCalTBEmShowerTuner::GetInstance();
+            if ( emShowerTuner->IsActive() ) emShowerTuner->AddDeposit( aStep->GetPreStepPoint()->GetPosition(), aStep->GetPreStepPoint()->GetTouchable(), edep * aStep->GetTrack()->GetWeight() );
+            #endif
+        }
     }
 
 }
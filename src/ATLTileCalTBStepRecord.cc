@@ -0,0 +1,72 @@
+//**************************************************
+// \file ATLTileCalTBStepRecord.cc
+// \brief: implementation of ATLTileCalTBStepRecord
+//         classes
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBStepRecord.hh"
+
+//Includers from Geant4
+//
+#include "G4Exception.hh"
+
+//Includers from C++
+//
+#include <algorithm>
+
+//IsValidHeader method
+//
+G4bool ATLTileCalTBStepRecordFile::IsValidHeader( const ATLTileCalTBStepRecordHeader& header ) {
+    return std::equal(std::begin(magic), std::end(magic), std::begin(header.magic)) &&
+           header.version == version &&
+           header.recordSize == sizeof(ATLTileCalTBStepRecord);
+}
+
+//OpenFile method
+//
+void ATLTileCalTBStepRecorder::OpenFile( const G4String& fileName ) {
+
+    fFile.open(fileName, std::ios::binary | std::ios::trunc);
+    if ( ! fFile ) {
+        G4ExceptionDescription msg;
+        msg << "Cannot open step record file " << fileName;
+        G4Exception("ATLTileCalTBStepRecorder::OpenFile()",
+        "MyCode0009", FatalException, msg);
+        return;
+    }
+
+    ATLTileCalTBStepRecordHeader header{};
+    std::copy(std::begin(ATLTileCalTBStepRecordFile::magic), std::end(ATLTileCalTBStepRecordFile::magic), header.magic);
+    header.version = ATLTileCalTBStepRecordFile::version;
+    header.recordSize = sizeof(ATLTileCalTBStepRecord);
+    fFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+}
+
+//CloseFile method
+//
+void ATLTileCalTBStepRecorder::CloseFile() {
+    fRecords.clear();
+    if ( fFile.is_open() ) fFile.close();
+}
+
+//WriteEvent method
+//
+void ATLTileCalTBStepRecorder::WriteEvent( std::uint32_t eventID, G4double eLeak, G4double eCal, G4double eLate, G4int pdgID, G4double eBeam ) {
+
+    if ( fFile.is_open() ) {
+        ATLTileCalTBStepRecordEvent event{ eventID, static_cast<std::uint32_t>(fRecords.size()),
+                                           eLeak, eCal, eLate, pdgID, static_cast<G4float>(eBeam) };
+        fFile.write(reinterpret_cast<const char*>(&event), sizeof(event));
+        fFile.write(reinterpret_cast<const char*>(fRecords.data()), fRecords.size() * sizeof(ATLTileCalTBStepRecord));
+    }
+    fRecords.clear();
+
+}
+
+//**************************************************
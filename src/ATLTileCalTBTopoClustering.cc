@@ -0,0 +1,137 @@
+//**************************************************
+// \file ATLTileCalTBTopoClustering.cc
+// \brief: implementation of ATLTileCalTBTopoClustering
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBTopoClustering.hh"
+#include "ATLTileCalTBConstants.hh"
+#include "ATLTileCalTBGeometry.hh"
+
+//Includers from Geant4
+//
+#include "G4Exception.hh"
+
+//Includers from C++
+//
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    constexpr std::size_t noLabel = std::numeric_limits<std::size_t>::max();
+}
+
+//Constructors
+//
+ATLTileCalTBTopoClustering::ATLTileCalTBTopoClustering()
+    : ATLTileCalTBTopoClustering(std::sqrt(2.) * ATLTileCalTBConstants::signal_noise_sigma,
+                                 ATLTileCalTBConstants::cluster_seed_threshold,
+                                 ATLTileCalTBConstants::cluster_grow_threshold,
+                                 ATLTileCalTBConstants::cluster_terminal_threshold) {
+}
+
+ATLTileCalTBTopoClustering::ATLTileCalTBTopoClustering( G4double noiseSigma, G4double seedThreshold,
+                                                        G4double growThreshold, G4double terminalThreshold )
+    : fSeedCut(seedThreshold * noiseSigma),
+      fGrowCut(growThreshold * noiseSigma),
+      fTerminalCut(terminalThreshold * noiseSigma),
+      fNoise(true),
+      fSeeds(),
+      fLabels(ATLTileCalTBGeometry::CellLUT::GetNumberOfCells(), noLabel),
+      fParents(),
+      fQueue(),
+      fClusters() {
+
+    if ( noiseSigma <= 0. || !(seedThreshold >= growThreshold && growThreshold >= terminalThreshold && terminalThreshold >= 0.) ) {
+        G4ExceptionDescription msg;
+        msg << "Topological clustering needs a positive noise sigma and seed >= grow >= terminal >= 0 thresholds";
+        G4Exception("ATLTileCalTBTopoClustering::ATLTileCalTBTopoClustering()", "MyCode0014", FatalException, msg);
+    }
+
+}
+
+//FindRoot method
+//
+std::size_t ATLTileCalTBTopoClustering::FindRoot( std::size_t label ) {
+    while ( fParents[label] != label ) {
+        fParents[label] = fParents[fParents[label]];
+        label = fParents[label];
+    }
+    return label;
+}
+
+//Run method
+//
+const std::vector<ATLTileCalTBTopoClustering::Cluster>& ATLTileCalTBTopoClustering::Run( const std::vector<G4double>& signal ) {
+
+    fClusters.clear();
+    std::fill(fLabels.begin(), fLabels.end(), noLabel);
+
+    //Cuts on the absolute signal, any signal without noise
+    const G4double seedCut = fNoise ? fSeedCut : 0.;
+    const G4double growCut = fNoise ? fGrowCut : 0.;
+    const G4double terminalCut = fNoise ? fTerminalCut : 0.;
+
+    //Seeds by decreasing significance, the label of a cluster is
+    //the position of its seed so that merged clusters keep the best one
+    fSeeds.clear();
+    for ( std::size_t n = 0; n < fLabels.size(); ++n ) {
+        if ( std::abs(signal[n]) > seedCut ) fSeeds.push_back(n);
+    }
+    if ( fSeeds.empty() ) return fClusters;
+    std::stable_sort(fSeeds.begin(), fSeeds.end(),
+                     [&signal](std::size_t a, std::size_t b) { return std::abs(signal[a]) > std::abs(signal[b]); });
+
+    fParents.resize(fSeeds.size());
+    fQueue.clear();
+    for ( std::size_t label = 0; label < fSeeds.size(); ++label ) {
+        fParents[label] = label;
+        fLabels[fSeeds[label]] = label;
+        fQueue.push_back(fSeeds[label]);
+    }
+
+    //Breadth-first growth, only cells above the grow threshold are queued
+    for ( std::size_t next = 0; next < fQueue.size(); ++next ) {
+        const std::size_t cell = fQueue[next];
+        const std::size_t root = FindRoot(fLabels[cell]);
+        for ( auto neighbour : ATLTileCalTBGeometry::CellLUT::GetNeighbours(cell) ) {
+            const G4double significance = std::abs(signal[neighbour]);
+            if ( significance <= terminalCut ) continue;
+            if ( fLabels[neighbour] == noLabel ) {
+                fLabels[neighbour] = root;
+                if ( significance > growCut ) fQueue.push_back(neighbour);
+            }
+            else if ( significance > growCut ) {
+                const std::size_t other = FindRoot(fLabels[neighbour]);
+                if ( other != root ) fParents[std::max(root, other)] = std::min(root, other);
+            }
+        }
+    }
+
+    //Cluster summaries
+    std::vector<std::size_t>& clusterIndex = fQueue;
+    clusterIndex.assign(fSeeds.size(), noLabel);
+    for ( std::size_t n = 0; n < fLabels.size(); ++n ) {
+        if ( fLabels[n] == noLabel ) continue;
+        const std::size_t root = FindRoot(fLabels[n]);
+        if ( clusterIndex[root] == noLabel ) {
+            clusterIndex[root] = fClusters.size();
+            fClusters.push_back({0., 0, static_cast<G4int>(fSeeds[root])});
+        }
+        auto& cluster = fClusters[clusterIndex[root]];
+        cluster.energy += signal[n];
+        ++cluster.noOfCells;
+    }
+    std::stable_sort(fClusters.begin(), fClusters.end(), [](const Cluster& a, const Cluster& b) { return a.energy > b.energy; });
+
+    return fClusters;
+
+}
+
+//**************************************************
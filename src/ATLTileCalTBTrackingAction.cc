@@ -0,0 +1,57 @@
+//**************************************************
+// \file ATLTileCalTBTrackingAction.cc
+// \brief: implementation of ATLTileCalTBTrackingAction
+//         class
+// \author: Lorenzo Pezzotti (CERN EP-SFT-sim)
+//          @lopezzot
+// \start date: 17 October 2026
+//**************************************************
+
+//Includers from project files
+//
+#include "ATLTileCalTBTrackingAction.hh"
+#include "ATLTileCalTBEventAction.hh"
+#ifdef ATLTileCalTB_FastSim
+#include "ATLTileCalTBShowerLibrary.hh"
+#endif
+
+//Includers from Geant4
+//
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4VProcess.hh"
+
+//Constructor and de-constructor
+//
+ATLTileCalTBTrackingAction::ATLTileCalTBTrackingAction( ATLTileCalTBEventAction* eventAction )
+    : G4UserTrackingAction(),
+      fEventAction(eventAction) {
+}
+
+ATLTileCalTBTrackingAction::~ATLTileCalTBTrackingAction() {}
+
+//PreUserTrackingAction method
+//
+#ifdef ATLTileCalTB_FastSim
+void ATLTileCalTBTrackingAction::PreUserTrackingAction( const G4Track* aTrack ) {
+    //Descendants of the shower library roots (generation mode)
+    //
+    auto showerRecorder = ATLTileCalTBShowerRecorder::GetInstance();
+    if ( showerRecorder->IsOpen() ) showerRecorder->AddTrack( aTrack );
+}
+#endif
+
+//PostUserTrackingAction method
+//
+void ATLTileCalTBTrackingAction::PostUserTrackingAction( const G4Track* aTrack ) {
+
+    //Only tracks ending after the time cut with some energy left
+    //(the process name is compared for these tracks only)
+    //
+    if ( aTrack->GetGlobalTime() <= fEventAction->GetTimeCut() || aTrack->GetKineticEnergy() <= 0. ) return;
+    const auto process = aTrack->GetStep()->GetPostStepPoint()->GetProcessDefinedStep();
+    if ( process && process->GetProcessName() == "nKiller" ) fEventAction->Add( 2, aTrack->GetKineticEnergy() * aTrack->GetWeight() );
+
+}
+
+//**************************************************
@@ -6,8 +6,6 @@
 // \start date: 28 August 2023
 //**************************************************
 
-#ifdef ATLTileCalTB_LEAKANALYSIS
-
 // Includers from project files
 //
 #include "SpectrumAnalyzer.hh"
@@ -36,6 +34,7 @@ void SpectrumAnalyzer::CreateNtupleAndScorer(const G4String scName)
   AM->CreateNtupleDColumn("gammaScore");
   AM->CreateNtupleDColumn("electronScore");
   AM->CreateNtupleDColumn("othersScore");
+  AM->CreateNtupleDColumn("neutrinoScore");
   AM->FinishNtuple();
 
   // Define scorer type
@@ -67,13 +66,15 @@ void SpectrumAnalyzer::FillEventFields() const
   AM->FillNtupleDColumn(ntupleID, 3, gammaScore);
   AM->FillNtupleDColumn(ntupleID, 4, electronScore);
   AM->FillNtupleDColumn(ntupleID, 5, othersScore);
+  AM->FillNtupleDColumn(ntupleID, 6, neutrinoScore);
   AM->AddNtupleRow(ntupleID);
 }
 
-void SpectrumAnalyzer::Analyze(const G4Step* step)
+void SpectrumAnalyzer::Analyze(const G4Track* track)
 {
-  auto PDGID = step->GetTrack()->GetParticleDefinition()->GetPDGEncoding();
-  auto val = scorer(step);
+  auto PDGID = track->GetParticleDefinition()->GetPDGEncoding();
+  // weighted (Russian roulette of ATLTileCalTBStackingAction)
+  auto val = scorer(track) * track->GetWeight();
 
   auto pTable = G4ParticleTable::GetParticleTable();
   const G4int neutronID = pTable->FindParticle("neutron")->GetPDGEncoding();
@@ -102,17 +103,21 @@ void SpectrumAnalyzer::Analyze(const G4Step* step)
     electronScore += val;
   }
   else {
+    // othersScore keeps the neutrinos, neutrinoScore is the neutrino part of it
     othersScore += val;
+    if (track->GetParticleDefinition()->GetParticleType() == "lepton"
+        && track->GetParticleDefinition()->GetPDGCharge() == 0.)
+    {
+      neutrinoScore += val;
+    }
   }
 
 #ifdef DEBUG
   G4cout << "-->SpectrumAnalyzer::Analyze, scorer name " << scorerName << " " << PDGID << " "
-         << step->GetTrack()->GetParticleDefinition()->GetParticleName() << " Total Energy "
-         << GetTE(step) << " Momentum " << GetMomentum(step) << " Kinetic Energy " << GetKE(step)
+         << track->GetParticleDefinition()->GetParticleName() << " Total Energy "
+         << GetTE(track) << " Momentum " << GetMomentum(track) << " Kinetic Energy " << GetKE(track)
          << G4endl;
 #endif
 }
 
-#endif // ATLTileCalTB_LEAKANALYSIS
-
 //**************************************************